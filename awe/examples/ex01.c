@@ -9,7 +9,7 @@ void timer_proc(void){
 
 void _drs_proc(AL_CONST AWE_RECT *r)
 {
-    blit(buffer, screen, r->left, r->top, r->left, r->top, AWE_RECT_WIDTH(*r), AWE_RECT_HEIGHT(*r));
+    awe_present_mouse_area(buffer, r->left, r->top, AWE_RECT_WIDTH(*r), AWE_RECT_HEIGHT(*r));
 }
 
 int main()
@@ -170,20 +170,16 @@ int main()
     do{
         AWE_RECT rect;
         if(!flag && mouse_x >= 10 && mouse_x < text_length(font1, "Hello World!") + 10 && mouse_y >= 12 && mouse_y < text_height(font1) + 12){
-            awe_scare_mouse();
             rectfill(buffer, 10, 12, text_length(font1, "Hello World!") + 10, text_height(font1) + 12,  makecol(200, 200, 200));
             textout(buffer, font1, "Hello World!", 10, 12, makecol(255, 0, 0));
-            awe_unscare_mouse();
             awe_set_mouse_cursor(hand);
             AWE_RECT_SET_S(rect, 10, 12, text_length(font1, "Hello World!") + 1, text_height(font1) + 1);
             _drs_proc(&rect);
             flag = 1;
         }
         else if(flag && !(mouse_x >= 10 && mouse_x < text_length(font1, "Hello World!") + 10 && mouse_y >= 12 && mouse_y < text_height(font1) + 12)){
-            awe_scare_mouse();
             rectfill(buffer, 10, 12, text_length(font1, "Hello World!") + 10, text_height(font1) + 12,  makecol(200, 200, 200));
             textout(buffer, font1, "Hello World!", 10, 12, makecol(255, 255, 255));
-            awe_unscare_mouse();
             awe_set_mouse_cursor(awe_get_system_cursor(AWE_MOUSE_ARROW));
             AWE_RECT_SET_S(rect, 10, 12, text_length(font1, "Hello World!") + 1, text_height(font1) + 1);
             _drs_proc(&rect);
@@ -19,6 +19,8 @@
 #include "awe/checkbox.h"
 #include "awe/radio.h"
 #include "awe/slider.h"
+#include "awe/loader.h"
+#include "awe/animation.h"
 
 #ifdef __cplusplus
    extern "C" {
@@ -0,0 +1,149 @@
+#ifndef AWE_ANIMATION_H
+#define AWE_ANIMATION_H
+
+
+#include <allegro.h>
+#include "input.h"
+#include "skin.h"
+#include "widget.h"
+
+
+#ifdef __cplusplus
+   extern "C" {
+#endif
+
+
+/**@name Animation
+    <p>The purpose of the Animation module is to run the frame animations of
+       widgets from a single clock. Each animation belongs to a widget and
+       steps through a number of frames in a given time, eased by a curve;
+       when the gui is updated, the widgets whose frame has changed are set
+       dirty, and only them. When no animation is running, the update does
+       no work at all.</p>
+    <p>Widgets get the frame to paint with awe_get_animation_frame. The
+       animations of a widget are paused while the widget is removed from
+       the screen, and stopped when the widget is destroyed.</p>
+ */
+/*@{*/
+
+
+/** looping of an animation
+ */
+enum AWE_ANIMATION_LOOP {
+    ///plays the frames once, then stays on the last frame
+    AWE_ANIMATION_ONCE,
+
+    ///plays the frames from the first to the last, repeatedly
+    AWE_ANIMATION_REPEAT,
+
+    ///plays the frames from the last to the first, repeatedly
+    AWE_ANIMATION_REVERSE,
+
+    ///plays the frames forth and back, repeatedly
+    AWE_ANIMATION_BACK
+};
+typedef enum AWE_ANIMATION_LOOP AWE_ANIMATION_LOOP;
+
+
+/** easing of an animation; it shapes the time it spends on each frame
+ */
+enum AWE_EASING {
+    ///frames take the same time
+    AWE_EASE_LINEAR,
+
+    ///starts slow and speeds up
+    AWE_EASE_IN,
+
+    ///starts fast and slows down
+    AWE_EASE_OUT,
+
+    ///starts and ends slow
+    AWE_EASE_IN_OUT
+};
+typedef enum AWE_EASING AWE_EASING;
+
+
+///animation handle
+typedef struct AWE_ANIMATION AWE_ANIMATION;
+
+
+/** starts an animation of a widget
+    @param wgt widget to set dirty when the frame changes
+    @param num_frames number of frames
+    @param duration time of a run through the frames, in miliseconds
+    @param loop looping of the animation
+    @param easing easing of the animation
+    @return the handle of the animation, or NULL if it could not be started
+ */
+AWE_ANIMATION *awe_start_animation(AWE_WIDGET *wgt, int num_frames, int duration, AWE_ANIMATION_LOOP loop, AWE_EASING easing);
+
+
+/** starts an animation of a widget as described by a skin; the speed of the
+    skin animation is the time of each frame, in miliseconds
+    @param wgt widget to set dirty when the frame changes
+    @param anim skin animation
+    @param easing easing of the animation
+    @return the handle of the animation, or NULL if the skin animation is
+            disabled or the animation could not be started
+ */
+AWE_ANIMATION *awe_start_skin_animation(AWE_WIDGET *wgt, const AWE_SKIN_ANIM *anim, AWE_EASING easing);
+
+
+/** stops an animation and releases its handle
+    @param anim handle of the animation
+ */
+void awe_stop_animation(AWE_ANIMATION *anim);
+
+
+/** stops the animations of a widget and its descentants
+    @param wgt root widget
+ */
+void awe_stop_widget_animations(AWE_WIDGET *wgt);
+
+
+/** pauses the running animations of a widget and its descentants; it is
+    called when the widget is removed from the screen
+    @param wgt root widget
+ */
+void awe_pause_widget_animations(AWE_WIDGET *wgt);
+
+
+/** resumes the paused animations of a widget and its descentants from the
+    frame they were paused at; it is called when the widget is put on the
+    screen
+    @param wgt root widget
+ */
+void awe_resume_widget_animations(AWE_WIDGET *wgt);
+
+
+/** returns the current frame of an animation
+    @param anim handle of the animation
+    @return the frame, from 0 to the number of frames minus 1
+ */
+int awe_get_animation_frame(const AWE_ANIMATION *anim);
+
+
+/** returns true if an animation is still running; an animation played once
+    stops running on its last frame
+    @param anim handle of the animation
+    @return non-zero if the animation is running
+ */
+int awe_is_animation_running(const AWE_ANIMATION *anim);
+
+
+/** advances the running animations to the current time, and sets dirty the
+    widgets whose frame has changed; it is called by awe_update_gui
+    @return the number of animations still running
+ */
+int awe_update_animations();
+
+
+/*@}*/
+
+
+#ifdef __cplusplus
+   }
+#endif
+
+
+#endif //AWE_ANIMATION_H
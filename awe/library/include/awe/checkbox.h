@@ -61,6 +61,7 @@ typedef enum AWE_TEXT_DIRECTION AWE_TEXT_DIRECTION;
 struct AWE_CHECKBOX {
     AWE_TOGGLE_BUTTON btn;
     RGB bg;
+    int bg_pix;
     int text_dir:1;
 };
 typedef struct AWE_CHECKBOX AWE_CHECKBOX;
@@ -78,6 +79,10 @@ extern AWE_CLASS awe_checkbox_class;
 extern AWE_OBJECT *awe_checkbox_clone(AWE_OBJECT *wgt);
 
 
+///makes the pixel values of the checkbox colors, if out of date; returns non-zero if they were made
+int awe_checkbox_make_colors(AWE_CHECKBOX *chk);
+
+
 void awe_checkbox_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *clip);
 void awe_checkbox_down(AWE_WIDGET *wgt, const AWE_EVENT *event);
 void awe_checkbox_up(AWE_WIDGET *wgt, const AWE_EVENT *event);
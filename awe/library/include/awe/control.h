@@ -33,6 +33,12 @@ struct AWE_CLASS;
         key it moves the focus around using the cursor keys, tab or tab+shift.
         This action takes place from inside the dialog's key down implementation.
     </p>
+    <p> A control may also report its hot key. The dialog keeps an index of the
+        hot keys of its descentants, so that an unused keypress is dispatched
+        only to the controls with a matching hot key and to the controls that
+        do not report one. The index is rebuilt when the widget tree changes or
+        when a control calls awe_control_hot_key_changed.
+    </p>
  */
 /*@{*/
 
@@ -50,6 +56,14 @@ struct AWE_CONTROL_VTABLE {
         @return non-zero if the keypress is processed, zero otherwise.
      */
     int (*key_press)(AWE_WIDGET *wgt, const AWE_EVENT *event);
+
+    /** optional method that returns the hot key of the control. If the
+        method is null, then the control receives all unused keypresses.
+        @param wgt widget that is being called
+        @return the lower case unicode character of the hot key or zero if
+                the control has no hot key
+     */
+    int (*get_hot_key)(AWE_WIDGET *wgt);
 };
 typedef struct AWE_CONTROL_VTABLE AWE_CONTROL_VTABLE;
 
@@ -64,13 +78,24 @@ typedef struct AWE_CONTROL_VTABLE AWE_CONTROL_VTABLE;
        manages the input focus. If left/up/tab+shift is pressed, then the focus
        is moved backward; if right/down/tab is pressed, then the focus is
        moved forward. If there is no other descentant widget to move the focus
-       to, then the focus is recycled.
+       to, then the focus is recycled. The focus order is the tree order,
+       except for widgets with a positive 'TabOrder' property, which come
+       first in ascending tab order. The order is kept per dialog and it is
+       recomputed only when the widget tree changes.
     @param wgt widget that is being called
     @param event key event 
  */
 void awe_dialog_key_down(AWE_WIDGET *wgt, const AWE_EVENT *event);
 
 
+/** notifies the dialogs that the hot key of a control has changed; controls
+    that implement the 'get_hot_key' method must call it whenever their hot
+    key changes.
+    @param wgt widget that its hot key has changed
+ */
+void awe_control_hot_key_changed(AWE_WIDGET *wgt);
+
+
 /*@}*/
 
 
@@ -32,6 +32,12 @@
         event grabbing, menus etc. Event manager procs can actually be
         registered only to the current event mode.
     </p>
+    <p> An event manager procedure can be registered for a subset of the event
+        types; each event mode keeps a table of procedures per event type, so
+        that an event only reaches the procedures that are interested in it.
+        The event mode stack has a fixed size and entering or leaving an
+        event mode does not allocate memory.
+    </p>
     <p> The following diagram shows a typical instance of the event system:
     </p>
     <pre>
@@ -81,6 +87,16 @@ enum AWE_EVENT_MODE_ACTION_TYPE {
 typedef enum AWE_EVENT_MODE_ACTION_TYPE AWE_EVENT_MODE_ACTION_TYPE;
 
 
+/** returns the event mask bit of an event type
+    @param TYPE event type
+ */
+#define AWE_EVENT_MASK(TYPE)      (1 << (TYPE))
+
+
+///event mask of all event types
+#define AWE_EVENT_MASK_ALL        (~0)
+
+
 /** type of event manager procedure
     @param action action type
     @param event input event; may be null, depending on action
@@ -98,6 +114,17 @@ typedef int (*AWE_EVENT_PROC)(AWE_EVENT_MODE_ACTION_TYPE action, AWE_EVENT *even
 void awe_add_event_proc(AWE_EVENT_PROC proc, void *data);
 
 
+/** registers an event procedure in the current event mode, for the given
+    event types only. The procedure is called with the 'do event' action only
+    for events with a type included in the mask. If the combination of
+    procedure and data is already registered, it is not registered again.
+    @param proc procedure to add to the current event mode
+    @param data user-defined data to pass to the procedure when it is called
+    @param types event mask; combination of AWE_EVENT_MASK values
+ */
+void awe_add_event_proc_ex(AWE_EVENT_PROC proc, void *data, int types);
+
+
 /** replaces an event procedure with another event procedure. It allows for
     procedures to nest. All entries equal to old proc are changed.
     @param new_proc new procedure
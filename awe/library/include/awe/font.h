@@ -23,6 +23,9 @@
     <LI>Loading of True Type Fonts; the system allows you to load true type fonts using the standared Allegro
         font structure.  The system also manages all the fonts for you.
     </LI>
+    <LI>Sharing of fonts; a font file or memory font is loaded once, and all its sizes share it.
+        Unloaded fonts may be kept around for reuse, within a memory budget.
+    </LI>
     </LL>
     <p>The Font module is an independent library.</p>
  */
@@ -41,6 +44,20 @@ void awe_set_font_alias(int alias);
 int awe_get_font_alias(void);
 
 
+/** sets the maximum size of the glyph cache; true type glyphs are
+    rasterized once per font and antialias mode and kept in atlas bitmaps;
+    when the cache is full, the least recently used atlas is reused
+    @param size maximum size in bytes
+ */
+void awe_set_font_cache_size(int size);
+
+
+/** returns the maximum size of the glyph cache
+    @return returns the maximum size of the glyph cache in bytes
+ */
+int awe_get_font_cache_size(void);
+
+
 /** initializes the font system if font_count is 0, increments font_count
     @return returns 1 on success, 0 otherwise
  */
@@ -53,18 +70,48 @@ int awe_install_font(void);
 FONT *awe_load_font(const char *path, int size);
 
 
-/** loads a font from memory
+/** loads a font from memory; the data must stay valid until the font is unloaded
     @return returns the loaded font or default font upon error
  */
 FONT *awe_load_memory_font(const char *data, int data_len, int size);
 
 
+/** loads a font file that has been read into memory, for example by another
+    thread; the font is shared by path and size as with awe_load_font, and
+    the data, allocated with malloc, is taken over in any case
+    @return returns the loaded font or default font upon error
+ */
+FONT *awe_load_font_data(const char *path, char *data, int data_len, int size);
+
+
 /** removes a font from the cache
     @return returns 1 if successful, 0 otherwise
  */
 int awe_unload_font(FONT *font);
 
 
+/** sets the memory budget of the fonts; unloaded fonts are kept for reuse
+    as long as the memory used by all fonts is within the budget, and then
+    destroyed least recently unloaded first; the default budget is 0
+    @param size budget in bytes
+ */
+void awe_set_font_budget(int size);
+
+
+/** returns the memory budget of the fonts
+    @return returns the budget in bytes
+ */
+int awe_get_font_budget(void);
+
+
+/** returns the memory used by a font, including its cached glyphs and its
+    face, which is shared with the other sizes of the font
+    @param font font to get the memory of; NULL for all fonts
+    @return returns the memory in bytes
+ */
+int awe_get_font_memory(FONT *font);
+
+
 /** cleans up and shuts down the font system if font_count is 1, decrements font_count
  */
 void awe_font_exit(void);
@@ -109,6 +109,12 @@ struct AWE_TEXTURE {
 typedef struct AWE_TEXTURE AWE_TEXTURE;
 
 
+/** type name of texture properties; skins find the texture properties of
+    widgets by it
+ */
+#define AWE_TEXTURE_PROPERTY "AWE_TEXTURE *"
+
+
 /** prepares a canvas for drawing; the point of origin is set to 0, 0
     @param canvas canvas to set up
     @param bmp destination bitmap
@@ -295,7 +301,8 @@ void awe_fill_circle(const AWE_CANVAS *canvas, int x, int y, int radius, int col
 void awe_fill_ellipse(const AWE_CANVAS *canvas, int x, int y, int hor_radius, int ver_radius, int color);
 
 
-/** rectangular gradient fill (using 'quad3d')
+/** rectangular gradient fill; gradients of up to 64K pixels are kept in a
+    small cache, so repeated gradients are blitted
     @param canvas destination canvas
     @param x1 left coordinate
     @param y1 top coordinate
@@ -309,7 +316,7 @@ void awe_fill_ellipse(const AWE_CANVAS *canvas, int x, int y, int hor_radius, in
 void awe_fill_gradient(const AWE_CANVAS *canvas, int x1, int y1, int x2, int y2, int color1, int color2, int color3, int color4);
 
 
-/** rectangular gradient fill (using 'quad3d') using position and size
+/** rectangular gradient fill using position and size
     @param canvas destination canvas
     @param x left coordinate
     @param y top coordinate
@@ -323,7 +330,7 @@ void awe_fill_gradient(const AWE_CANVAS *canvas, int x1, int y1, int x2, int y2,
 void awe_fill_gradient_s(const AWE_CANVAS *canvas, int x, int y, int w, int h, int color1, int color2, int color3, int color4);
 
 
-/** horizontal gradient fill (using 'quad3d')
+/** horizontal gradient fill
     @param canvas destination canvas
     @param x1 left coordinate
     @param y1 top coordinate
@@ -335,7 +342,7 @@ void awe_fill_gradient_s(const AWE_CANVAS *canvas, int x, int y, int w, int h, i
 void awe_fill_gradient_hor(const AWE_CANVAS *canvas, int x1, int y1, int x2, int y2, int color1, int color2);
 
 
-/** horizontal gradient fill (using 'quad3d') using position and size
+/** horizontal gradient fill using position and size
     @param canvas destination canvas
     @param x left coordinate
     @param y top coordinate
@@ -347,7 +354,7 @@ void awe_fill_gradient_hor(const AWE_CANVAS *canvas, int x1, int y1, int x2, int
 void awe_fill_gradient_hor_s(const AWE_CANVAS *canvas, int x, int y, int w, int h, int color1, int color2);
 
 
-/** vertical gradient fill (using 'quad3d')
+/** vertical gradient fill
     @param canvas destination canvas
     @param x1 left coordinate
     @param y1 top coordinate
@@ -359,7 +366,7 @@ void awe_fill_gradient_hor_s(const AWE_CANVAS *canvas, int x, int y, int w, int
 void awe_fill_gradient_ver(const AWE_CANVAS *canvas, int x1, int y1, int x2, int y2, int color1, int color2);
 
 
-/** vertical gradient fill (using 'quad3d') using position and size
+/** vertical gradient fill using position and size
     @param canvas destination canvas
     @param x left coordinate
     @param y top coordinate
@@ -567,6 +574,32 @@ void awe_draw_rect_pattern(const AWE_CANVAS *canvas, int x1, int y1, int x2, int
 void awe_draw_rect_pattern_s(const AWE_CANVAS *canvas, int x, int y, int w, int h, int color, unsigned pt);
 
 
+/** returns the length of an Allegro string; the length is cached per font
+    and string, so measuring the same text again is cheap
+    @param font font of the text
+    @param text NULL-terminated Allegro string
+    @return length of the text in pixels
+ */
+int awe_get_text_length(const FONT *font, const char *text);
+
+
+/** returns the length of an Allegro string as drawn by awe_draw_gui_text;
+    the length is cached like in awe_get_text_length
+    @param font font of the text
+    @param text NULL-terminated Allegro string
+    @return length of the text in pixels
+ */
+int awe_get_gui_text_length(const FONT *font, const char *text);
+
+
+/** flushes the cached text lengths of a font; fonts loaded with
+    awe_load_font are flushed when they are destroyed, other fonts must be
+    flushed by the application before they are destroyed
+    @param font font to flush the lengths of; NULL flushes all fonts
+ */
+void awe_flush_text_metrics(const FONT *font);
+
+
 /** draws an Allegro string of a specific length
     @param canvas destination canvas
     @param font font to use for the text output
@@ -860,6 +893,63 @@ AWE_TEXTURE *awe_create_texture(BITMAP *src, int x, int y, int w, int h, int lef
 void awe_destroy_texture(AWE_TEXTURE *texture);
 
 
+/** sets the memory budget of the texture cache; textures drawn at a size
+    are rendered once and kept, so as that drawing them again is one blit;
+    renderings bigger than a quarter of the budget are not kept, and the
+    least recently used renderings are dropped to fit in the budget
+    @param size budget in bytes; 0 disables the cache
+ */
+void awe_set_texture_cache_size(int size);
+
+
+/** returns the memory budget of the texture cache
+    @return the budget in bytes
+ */
+int awe_get_texture_cache_size(void);
+
+
+/** drops the cached renderings of a texture; it must be called when the
+    bitmaps of a texture are changed in place
+    @param texture texture to flush the renderings of
+ */
+void awe_flush_texture_cache(const AWE_TEXTURE *texture);
+
+
+/** returns the version of the color conversion; it changes when the color
+    depth of the gui screen changes, and when awe_invalidate_colors is
+    called. Widgets keep the pixel values of their colors along with the
+    version they were made at, and make them again when it has changed;
+    the gui repaints all widgets when it changes.
+    @return the version of the color conversion; never 0
+ */
+unsigned awe_get_color_version(void);
+
+
+/** checks the color depth of a bitmap against the one the colors were last
+    made for; if it is different, the color version is changed. It is called
+    by awe_update_gui with the gui screen.
+    @param bmp bitmap that widgets are drawn to
+    @return non-zero if the color depth has changed
+ */
+int awe_check_color_depth(BITMAP *bmp);
+
+
+/** changes the color version, so as that widgets make the pixel values of
+    their colors again; it must be called when the palette is changed in
+    8-bit modes
+ */
+void awe_invalidate_colors(void);
+
+
+/** converts the RGB color of text shadows to a pixel value; shadows of
+    magenta color are not drawn
+    @param s color of the shadow
+    @return pixel value for current video mode, or -1 if the shadow is not
+            drawn
+ */
+int awe_make_shadow_color(RGB s);
+
+
 /** draws a texture on a canvas
     @param canvas destination canvas
     @param tex texture to draw
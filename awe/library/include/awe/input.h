@@ -25,6 +25,13 @@
     <LI> Events can be inserted into the queue; used for simulated input
          (robot programs etc).
     </LI>
+    <LI> Optional input thread with batched event delivery; the events put
+         during a frame are handed to the application all at once, so
+         that reading events never waits for the input callbacks.
+    </LI>
+    <LI> Mouse and keyboard events can be recorded to a file and replayed
+         later on a virtual clock, for repeatable sessions.
+    </LI>
     </LL>
     <p>The Input module is indepentent from widgets; it can also be used for
        managing the input of a game in the main game loop.</p>
@@ -57,7 +64,10 @@ enum AWE_EVENT_TYPE {
     AWE_EVENT_KEY_UP,
 
     ///timer event
-    AWE_EVENT_TIMER
+    AWE_EVENT_TIMER,
+
+    ///asynchronous load finished event
+    AWE_EVENT_LOAD
 };
 typedef enum AWE_EVENT_TYPE AWE_EVENT_TYPE;
 
@@ -125,6 +135,20 @@ struct AWE_TIMER_EVENT {
 typedef struct AWE_TIMER_EVENT AWE_TIMER_EVENT;
 
 
+///load event structure
+struct AWE_LOAD_EVENT {
+    ///event type
+    AWE_EVENT_TYPE type;
+
+    ///unused; load events are put from loader threads, outside of the input clock
+    unsigned time;
+
+    ///AWE_LOAD handle of the finished load
+    void *load;
+};
+typedef struct AWE_LOAD_EVENT AWE_LOAD_EVENT;
+
+
 /** event structure; it is a union of the structures mentioned above. It must
     be used according to the event type.
  */
@@ -140,6 +164,9 @@ union AWE_EVENT {
 
     ///timer information
     AWE_TIMER_EVENT timer;
+
+    ///load information
+    AWE_LOAD_EVENT load;
 };
 typedef union AWE_EVENT AWE_EVENT;
 
@@ -169,10 +196,11 @@ typedef int (*AWE_EVENT_ENUM_PROC)(AWE_EVENT *event, void *cb_data);
 void awe_install_input();
 
 
-/** puts an event to the event queue
+/** puts an event to the event queue; it may be called from any thread
     @param event event to copy to the internal queue
+    @return zero if the queue is full
  */
-void awe_put_event(const AWE_EVENT *event);
+int awe_put_event(const AWE_EVENT *event);
 
 
 /** gets an event from the event queue
@@ -199,6 +227,12 @@ int awe_add_timer(void *data, int id, int msecs);
 int awe_remove_timer(void *data, int id);
 
 
+/** returns the time of the input clock; events are stamped with it
+    @return time in miliseconds since the input system was installed
+ */
+unsigned awe_get_input_time();
+
+
 /** enumerates the set timers
     @param proc enumerate proc
     @param data callback data
@@ -213,6 +247,67 @@ void awe_enum_timers(AWE_TIMER_ENUM_PROC proc, void *data);
 void awe_enum_events(AWE_EVENT_ENUM_PROC proc, void *data);
 
 
+/** starts the input thread and batched event delivery. The thread polls
+    the input devices that need polling. While batching, input callbacks
+    put events to a back queue, coalescing consecutive mouse moves, and
+    awe_get_event reads from a front queue without locking; the queues are
+    swapped by awe_swap_events, which should be called once per frame.
+    @return zero if the thread could not be started
+ */
+int awe_start_input_thread();
+
+
+/** stops the input thread and batched event delivery. Events not yet
+    delivered remain in the queue.
+ */
+void awe_stop_input_thread();
+
+
+/** delivers the batch of events put since the previous call, if the
+    previous batch has been read completely by awe_get_event. It does
+    nothing if the input thread is not started.
+ */
+void awe_swap_events();
+
+
+/** starts recording the mouse and keyboard events returned by awe_get_event
+    to a file. Each event is stored with its delay from the previous one.
+    Timer events are not recorded, since they are produced by the application.
+    @param filename file to write the events to
+    @return zero if the file could not be created
+ */
+int awe_start_event_recording(const char *filename);
+
+
+/** stops recording events and closes the record file
+ */
+void awe_stop_event_recording();
+
+
+/** starts replaying a file made by awe_start_event_recording. While the
+    replay is active, mouse and keyboard input from the devices is ignored;
+    events are put to the queue only by awe_advance_event_replay.
+    @param filename file to read the events from
+    @return zero if the file could not be opened or it is not an event file
+ */
+int awe_start_event_replay(const char *filename);
+
+
+/** stops replaying events; device input is accepted again
+ */
+void awe_stop_event_replay();
+
+
+/** advances the virtual replay clock and puts the events that became due
+    to the event queue. The time of the events is the virtual clock time at
+    which they were recorded. If the queue fills up, the remaining due
+    events are put on the next call.
+    @param msecs miliseconds to advance the virtual clock by
+    @return zero if the replay has finished
+ */
+int awe_advance_event_replay(unsigned msecs);
+
+
 /*@}*/
 
 
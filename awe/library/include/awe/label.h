@@ -37,6 +37,8 @@ typedef enum AWE_LABEL_STATE AWE_LABEL_STATE;
 struct AWE_LABEL_COLOR {
     RGB font_col;
     RGB font_sdw;
+    int font_pix;
+    int sdw_pix;
 };
 typedef struct AWE_LABEL_COLOR AWE_LABEL_COLOR;
 
@@ -46,7 +48,10 @@ struct AWE_LABEL {
     AWE_WIDGET widget;
     char *text;
     FONT *font;
+    int text_width;
+    int text_height;
     AWE_LABEL_COLOR color[AWE_LABEL_NUM_STATES];
+    unsigned color_version;
 };
 typedef struct AWE_LABEL AWE_LABEL;
 
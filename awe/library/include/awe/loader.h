@@ -0,0 +1,123 @@
+#ifndef AWE_LOADER_H
+#define AWE_LOADER_H
+
+
+#include <allegro.h>
+#include "input.h"
+#include "skin.h"
+#include "font.h"
+#include "mouse.h"
+
+
+#ifdef __cplusplus
+   extern "C" {
+#endif
+
+
+/**@name Loader
+    <p>The purpose of the Loader module is to load skins, fonts and cursor
+       sets without blocking the gui. Each load reads and decodes its file
+       on a thread of its own; when it is done, a load event is put to the
+       event queue, and awe_do_events finishes the load on the gui thread
+       and calls the completion procedure, so as that the application keeps
+       drawing and handling events while its assets load.</p>
+    <p>The work that touches shared state, like registering a font or
+       creating the cursors of a cursor set, is done when the load is
+       finished. Loaders change the color conversion of Allegro while
+       reading datafiles with an alpha channel; loads read their datafiles
+       one at a time, but the application should not load images of its
+       own while loads are in progress.</p>
+ */
+/*@{*/
+
+
+/** type of load
+ */
+enum AWE_LOAD_TYPE {
+    ///load of a skin; the result is an AWE_SKIN pointer
+    AWE_LOAD_SKIN,
+
+    ///load of a font; the result is a FONT pointer
+    AWE_LOAD_FONT,
+
+    ///load of a cursor set; the result is the datafile of the cursor set
+    AWE_LOAD_MOUSE
+};
+typedef enum AWE_LOAD_TYPE AWE_LOAD_TYPE;
+
+
+///load handle
+typedef struct AWE_LOAD AWE_LOAD;
+
+
+/** type of procedure called on the gui thread when a load is finished
+    @param load handle of the load; it is released after the call
+    @param result loaded object, as the load type says; NULL if the load failed
+    @param data user data, as given when the load was started
+ */
+typedef void (*AWE_LOAD_PROC)(AWE_LOAD *load, void *result, void *data);
+
+
+/** starts loading a skin; the cursors of the skin are loaded when the load
+    is finished, like awe_load_skin does
+    @param filename path to skin
+    @param proc procedure to call when the load is finished
+    @param data user data to pass to the procedure
+    @return the handle of the load, or NULL if the load could not be started
+ */
+AWE_LOAD *awe_load_skin_async(const char *filename, AWE_LOAD_PROC proc, void *data);
+
+
+/** starts loading a font; the font file is read by the loader thread, and
+    the font is registered when the load is finished. The result is the
+    default font if the font can not be loaded, like awe_load_font does.
+    @param path path to the font file
+    @param size size of the font
+    @param proc procedure to call when the load is finished
+    @param data user data to pass to the procedure
+    @return the handle of the load, or NULL if the load could not be started
+ */
+AWE_LOAD *awe_load_font_async(const char *path, int size, AWE_LOAD_PROC proc, void *data);
+
+
+/** starts loading a cursor set; the cursors are created and set when the
+    load is finished, like awe_load_mouse does
+    @param path path to the datafile containing the cursor set
+    @param proc procedure to call when the load is finished
+    @param data user data to pass to the procedure
+    @return the handle of the load, or NULL if the load could not be started
+ */
+AWE_LOAD *awe_load_mouse_async(const char *path, AWE_LOAD_PROC proc, void *data);
+
+
+/** returns the type of a load
+    @param load handle of the load
+    @return the type of the load
+ */
+AWE_LOAD_TYPE awe_get_load_type(AWE_LOAD *load);
+
+
+/** cancels a load; the load is not stopped, but its result is discarded when
+    it is finished and the completion procedure is not called
+    @param load handle of the load
+ */
+void awe_cancel_load(AWE_LOAD *load);
+
+
+/** finishes a load on the gui thread; it is called by awe_do_events when it
+    gets a load event, and it must be called by applications that read load
+    events with awe_get_event themselves
+    @param load handle of the load, as found in the load event
+ */
+void awe_finish_load(AWE_LOAD *load);
+
+
+/*@}*/
+
+
+#ifdef __cplusplus
+   }
+#endif
+
+
+#endif //AWE_LOADER_H
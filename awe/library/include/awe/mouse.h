@@ -27,6 +27,11 @@ extern "C" {
     <LI>Themed cursors; A default system cursor set is loaded initially but additional themes can be installed.
     </LI>
     </LL>
+    <p>When the mouse is shown on a memory bitmap the gui is drawn onto, the cursor is never drawn
+    onto that bitmap; it is composited over the areas of the bitmap as they are presented to the mouse
+    screen with awe_present_mouse_area, so as that drawing does not need to hide the cursor. When the
+    mouse is shown on the mouse screen itself, the cursor is drawn onto it and has to be scared
+    while drawing under it.</p>
     <p>The Mouse module is an independent library.</p>
  */
 /*@{*/
@@ -186,11 +191,39 @@ int awe_load_mouse(const char *path);
 int awe_load_datafile_mouse(DATAFILE *dat);
 
 
+/** reads a cursor set datafile without touching the current cursors; it
+    may be called from another thread than the one using the mouse
+    @param path path to the datafile containing the cursor set
+    @return the datafile, or NULL if it could not be read
+ */
+DATAFILE *awe_read_mouse_datafile(const char *path);
+
+
+/** loads a cursor set from a datafile read by awe_read_mouse_datafile; the
+    datafile is unloaded when the cursor set is replaced
+    @param path path the datafile was read from
+    @param dat datafile containing the cursor set; NULL loads the default cursors
+ */
+int awe_adopt_mouse_datafile(const char *path, DATAFILE *dat);
+
+
 /** forces the redraw of the mouse
  */
 void awe_redraw_mouse();
 
 
+/** copies an area of a bitmap to the mouse screen; if the mouse is shown on the
+    bitmap, the cursor is composited over the part of the area it covers. It
+    should be used instead of blit for presenting the bitmap the mouse is shown on.
+    @param bmp bitmap to copy from
+    @param x left coordinate of the area
+    @param y top coordinate of the area
+    @param w width of the area
+    @param h height of the area
+ */
+void awe_present_mouse_area(BITMAP *bmp, int x, int y, int w, int h);
+
+
 /** updates the mouse
  */
 void awe_update_mouse(void);
@@ -230,7 +263,8 @@ AWE_CURSOR *awe_get_system_cursor(AWE_CURSOR_TYPE type);
 AWE_CURSOR *awe_set_mouse_cursor(AWE_CURSOR *cursor);
 
 
-/** shows the mouse to the specified bitmap
+/** shows the mouse to the specified bitmap; if the bitmap is not the mouse
+    screen, the cursor is composited over it as it is presented
  */
 void awe_show_mouse(BITMAP *bmp);
 
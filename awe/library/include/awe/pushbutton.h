@@ -300,6 +300,10 @@ struct AWE_PUSH_BUTTON_STATE {
     RGB font_col;
     RGB font_sdw;
     AWE_TEXTURE *texture;
+    int face_pix[AWE_PUSH_BUTTON_NUM_FACES];
+    int edge_pix[AWE_PUSH_BUTTON_NUM_EDGES];
+    int font_pix;
+    int sdw_pix;
 };
 typedef struct AWE_PUSH_BUTTON_STATE AWE_PUSH_BUTTON_STATE;
 
@@ -312,7 +316,11 @@ struct AWE_PUSH_BUTTON {
     FONT *font;
     BITMAP *bitmap;
     char *text;
+    int hot_key;
+    int text_width;
+    int text_height;
     short border;
+    unsigned color_version;
     int pressed:1;
     int lostmouse:1;
     int bitmap_dir:1;
@@ -345,6 +353,10 @@ void *awe_push_button_get_interface(AWE_OBJECT *obj, const char *name, const cha
 AWE_OBJECT *awe_push_button_clone(AWE_OBJECT *wgt);
 
 
+///makes the pixel values of the push button colors, if out of date; returns non-zero if they were made
+int awe_push_button_make_colors(AWE_PUSH_BUTTON *btn);
+
+
 ///paints a push button
 void awe_push_button_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *clip);
 
@@ -361,6 +373,10 @@ void awe_push_button_up(AWE_WIDGET *wgt, const AWE_EVENT *event);
 int awe_push_button_key_press(AWE_WIDGET *wgt, const AWE_EVENT *event);
 
 
+///returns the push button hot key
+int awe_push_button_get_hot_key(AWE_WIDGET *wgt);
+
+
 ///push button got mouse event
 void awe_push_button_mouse_enter(AWE_WIDGET *wgt, const AWE_EVENT *event);
 
@@ -4,8 +4,10 @@
 
 #include <allegro.h>
 #include <string.h>
+#include <time.h>
 #include "gdi.h"
 #include "com.h"
+#include "widget.h"
 #include "symbintree.h"
 #include "mouse.h"
 #include "font.h"
@@ -28,13 +30,51 @@ struct AWE_SKIN {
     /// skin datafile
     DATAFILE *dat;
 
-    /// object list loaded from datafile
+    /// object list used while loading
     AWE_SBT_NODE *obj_list;
+
+    /// objects sorted by name; the position of an object is its handle
+    void **objects;
+
+    /// number of objects
+    int object_count;
+
+    /// hash table of object handles, -1 for empty slots
+    int *hash;
+
+    /// size of the hash table minus one; the size is a power of 2
+    int hash_mask;
+
+    /// atlas bitmaps the datafile bitmaps are packed into
+    BITMAP **atlas;
+
+    /// number of atlas bitmaps
+    int atlas_count;
+
+    /// image of a compiled skin, which its objects point into; NULL for datafile skins
+    void *image;
+
+    /// objects waiting to be prefetched, last one first
+    void **prefetch;
+
+    /// number of objects waiting to be prefetched
+    int prefetch_count;
+
+    /// path the skin was loaded from
+    char *filename;
+
+    /// modification time of the skin file when it was loaded
+    time_t file_time;
 };
 typedef struct AWE_SKIN AWE_SKIN;
 
 
-/** skin vtable
+///skin interface name
+#define AWE_ID_SKIN             "Skin"
+
+
+/** skin vtable; widgets implementing it are asked to pick their objects
+    again from a skin that has been reloaded
  */
 struct AWE_SKIN_VTABLE {
     /// apply skin function
@@ -76,19 +116,95 @@ struct AWE_SKIN_ANIM {
 typedef struct AWE_SKIN_ANIM AWE_SKIN_ANIM;
 
 
-/** loads a skin
+/** loads a skin; the skin may be a datafile or a compiled skin
     @param filename path to skin
     @return returns a valid AWE_SKIN pointer, otherwise NULL
  */
 AWE_SKIN *awe_load_skin(const char *filename);
 
 
+/** loads a skin without loading its cursors; it does not touch the gui, so
+    it may be called from another thread. The cursors of the skin are loaded
+    afterwards with awe_load_datafile_mouse(skn->dat).
+    @param filename path to skin
+    @return returns a valid AWE_SKIN pointer, otherwise NULL
+ */
+AWE_SKIN *awe_read_skin(const char *filename);
+
+
+/** compiles a skin datafile; a compiled skin holds its objects already
+    resolved and sorted by name, and its bitmaps already packed and converted
+    to the current color depth, so as that it is loaded with a single read.
+    compiled skins are tied to the byte order of the machine compiling them.
+    @param filename path to skin datafile
+    @param compiled path of the compiled skin to write
+    @return returns non-zero on success, otherwise zero
+ */
+int awe_compile_skin(const char *filename, const char *compiled);
+
+
 /** unloads a skin
     @param skn valid AWE_SKIN pointer
  */
 void awe_unload_skin(AWE_SKIN *skn);
 
 
+/** reloads a skin in place, or switches it to another skin file. Textures
+    keep their address and are updated with the new pixels; fonts and
+    bitmaps referenced by widget properties are replaced through the
+    properties, and widgets implementing the skin interface get their
+    apply_skin method called. Color properties of widgets that hold the old
+    value of a skin color are set to the new value of the color with the
+    same name. Only widgets referencing objects that changed are redrawn.
+    Colors, data and handles of the old skin, and its prefetch list, are not
+    valid after the reload.
+    @param skn valid AWE_SKIN pointer
+    @param filename path to skin; NULL reloads the file the skin was loaded from
+    @param wgt widget tree to update; NULL for the tree of the root widget
+    @return returns non-zero on success, otherwise zero and the skin is left as it was
+ */
+int awe_reload_skin(AWE_SKIN *skn, const char *filename, AWE_WIDGET *wgt);
+
+
+/** reloads a skin if its file has been modified since it was loaded; meant
+    to be called periodically from the event loop while a skin is edited
+    @param skn valid AWE_SKIN pointer
+    @param wgt widget tree to update; NULL for the tree of the root widget
+    @return returns non-zero if the skin was reloaded, otherwise zero
+ */
+int awe_update_skin(AWE_SKIN *skn, AWE_WIDGET *wgt);
+
+
+/** sets the objects of a skin to create ahead of their first use. Skin
+    textures, fonts and bitmaps are created when they are first retrieved;
+    objects in the prefetch list are created by awe_prefetch_skin instead,
+    a few at a time.
+    @param skn valid AWE_SKIN pointer
+    @param names names of objects, terminated by NULL; unknown names are ignored
+    @return returns non-zero on success, otherwise zero
+ */
+int awe_set_skin_prefetch_list(AWE_SKIN *skn, const char **names);
+
+
+/** creates objects of the prefetch list; meant to be called from the event
+    loop while there are no events to process
+    @param skn valid AWE_SKIN pointer
+    @param count maximum number of objects to create
+    @return returns the number of objects left to prefetch
+ */
+int awe_prefetch_skin(AWE_SKIN *skn, int count);
+
+
+/** returns the handle of a skin object; handles are positions in the
+    skin's name index and stay valid until the skin is unloaded or
+    reloaded, so that callers can look a name up once and keep the handle
+    @param skn valid AWE_SKIN pointer
+    @param name name of object
+    @return returns the handle of the object, otherwise -1
+ */
+int awe_get_skin_handle(AWE_SKIN *skn, const char *name);
+
+
 /** retrieves a skin texture
     @param skn valid AWE_SKIN pointer
     @param name name of texture
@@ -97,6 +213,14 @@ void awe_unload_skin(AWE_SKIN *skn);
 AWE_TEXTURE *awe_get_skin_texture(AWE_SKIN *skn, const char *name);
 
 
+/** retrieves a skin texture by handle
+    @param skn valid AWE_SKIN pointer
+    @param handle handle of texture
+    @return returns a valid AWE_TEXTURE pointer, otherwise NULL
+ */
+AWE_TEXTURE *awe_get_skin_texture_by_handle(AWE_SKIN *skn, int handle);
+
+
 /** retrieves a skin RGB structure
     @param skn valid AWE_SKIN pointer
     @param name name of RGB structure
@@ -105,6 +229,14 @@ AWE_TEXTURE *awe_get_skin_texture(AWE_SKIN *skn, const char *name);
 RGB *awe_get_skin_color(AWE_SKIN *skn, const char *name);
 
 
+/** retrieves a skin RGB structure by handle
+    @param skn valid AWE_SKIN pointer
+    @param handle handle of RGB structure
+    @return returns a valid RGB pointer, otherwise the default color
+ */
+RGB *awe_get_skin_color_by_handle(AWE_SKIN *skn, int handle);
+
+
 /** retrieves a skin FONT structure
     @param skn valid AWE_SKIN pointer
     @param name name of FONT structure
@@ -113,6 +245,14 @@ RGB *awe_get_skin_color(AWE_SKIN *skn, const char *name);
 FONT *awe_get_skin_font(AWE_SKIN *skn, const char *name);
 
 
+/** retrieves a skin FONT structure by handle
+    @param skn valid AWE_SKIN pointer
+    @param handle handle of FONT structure
+    @return returns a valid FONT pointer, otherwise the default font
+ */
+FONT *awe_get_skin_font_by_handle(AWE_SKIN *skn, int handle);
+
+
 /** retrieves a skin BITMAP structure
     @param skn valid AWE_SKIN pointer
     @param name name of BITMAP structure
@@ -121,6 +261,14 @@ FONT *awe_get_skin_font(AWE_SKIN *skn, const char *name);
 BITMAP *awe_get_skin_bitmap(AWE_SKIN *skn, const char *name);
 
 
+/** retrieves a skin BITMAP structure by handle
+    @param skn valid AWE_SKIN pointer
+    @param handle handle of BITMAP structure
+    @return returns a valid BITMAP pointer, otherwise NULL
+ */
+BITMAP *awe_get_skin_bitmap_by_handle(AWE_SKIN *skn, int handle);
+
+
 /** retrieves a skin SKIN_ANIM structure
     @param skn valid AWE_SKIN pointer
     @param name name of SKIN_ANIM structure
@@ -129,6 +277,14 @@ BITMAP *awe_get_skin_bitmap(AWE_SKIN *skn, const char *name);
 AWE_SKIN_ANIM *awe_get_skin_anim(AWE_SKIN *skn, const char *name);
 
 
+/** retrieves a skin SKIN_ANIM structure by handle
+    @param skn valid AWE_SKIN pointer
+    @param handle handle of SKIN_ANIM structure
+    @return returns a valid SKIN_ANIM pointer, otherwise a default value
+ */
+AWE_SKIN_ANIM *awe_get_skin_anim_by_handle(AWE_SKIN *skn, int handle);
+
+
 /** retrieves a skin binary data structure
     @param skn valid binary data pointer
     @param name name of a binary data structure
@@ -137,6 +293,14 @@ AWE_SKIN_ANIM *awe_get_skin_anim(AWE_SKIN *skn, const char *name);
 void *awe_get_skin_data(AWE_SKIN *skn, const char *name);
 
 
+/** retrieves a skin binary data structure by handle
+    @param skn valid AWE_SKIN pointer
+    @param handle handle of a binary data structure
+    @return returns a valid binary data pointer, otherwise NULL
+ */
+void *awe_get_skin_data_by_handle(AWE_SKIN *skn, int handle);
+
+
 /** retrieves a skin integer
     @param skn valid AWE_SKIN pointer
     @param name name of integer
@@ -146,6 +310,15 @@ void *awe_get_skin_data(AWE_SKIN *skn, const char *name);
 int awe_get_skin_int(AWE_SKIN *skn, const char *name, int num);
 
 
+/** retrieves a skin integer by handle
+    @param skn valid AWE_SKIN pointer
+    @param handle handle of integer
+    @param num default value if integer value not found
+    @return returns a valid integer, otherwise num
+ */
+int awe_get_skin_int_by_handle(AWE_SKIN *skn, int handle, int num);
+
+
 /*@}*/
 
 
@@ -135,6 +135,12 @@ struct AWE_SLIDER {
     RGB bar_col[AWE_SLIDER_NUM_EDGES];
     RGB edge_col[AWE_SLIDER_NUM_TEXTURES][AWE_SLIDER_NUM_EDGES];
     RGB face_col[AWE_SLIDER_NUM_TEXTURES];
+    int bar_pix[AWE_SLIDER_NUM_EDGES];
+    int edge_pix[AWE_SLIDER_NUM_TEXTURES][AWE_SLIDER_NUM_EDGES];
+    int face_pix[AWE_SLIDER_NUM_TEXTURES];
+    int bg_pix;
+    int focus_pix;
+    unsigned color_version;
     AWE_DL_LIST label_table;
     AWE_SLIDER_HANDLE_TYPE handle_type;
     AWE_SLIDER_ORIENTATION orientation;
@@ -109,6 +109,14 @@ void *awe_sbt_find(AWE_SBT_NODE *root, void *data, int (*compare_func)(const voi
 void awe_sbt_destroy(AWE_SBT_NODE **root, void (*delete_func)(const void *data));
 
 
+/** calls a function for the data of every node, in sorted order
+   @param root root node
+   @param walk_func function called with the data of a node and the given argument
+   @param arg argument passed to the function
+ */
+void awe_sbt_walk(AWE_SBT_NODE *root, void (*walk_func)(void *data, void *arg), void *arg);
+
+
 /*@}*/
 
 
@@ -31,6 +31,8 @@
         <ol>Opaque: boolean; if not true, widget is show through</ol>
         <ol>Translucency: 0 to 255; if < 255, widget is translucent</ol> 
         <ol>OutputType: see enum AWE_WIDGET_OUTPUT_TYPE</ol>
+        <ol>TabOrder: int; if > 0, the widget receives the dialog focus before
+            the widgets with a zero tab order, in ascending order</ol>
         </li>
     <li>focus widget tree management; at any point in time, only one widget
         has the input focus.</li>
@@ -72,6 +74,9 @@
 ///output type property name
 #define AWE_ID_OUTPUT_TYPE      "OutputType"
 
+///tab order property name
+#define AWE_ID_TAB_ORDER        "TabOrder"
+
 
 ///update mode for the GUI
 enum AWE_GUI_UPDATE_MODE {
@@ -122,6 +127,7 @@ struct AWE_WIDGET {
     AWE_RECT dirty;
     AWE_WIDGET_OUTPUT_TYPE output_type;
     BITMAP *buffer;
+    int tab_order;
     unsigned translucency:8;
     unsigned on_screen:1;
     unsigned drawable:1;
@@ -962,6 +968,15 @@ int awe_add_widget(AWE_WIDGET *parent, AWE_WIDGET *child);
 int awe_remove_widget(AWE_WIDGET *wgt);
 
 
+/** returns the version of the widget trees. The version changes each time
+    a widget is inserted, removed or has its z-order or tab order changed;
+    it can be used
+    for invalidating information that is computed from widget trees.
+    @return the current version of the widget trees
+ */
+unsigned awe_get_widget_tree_version();
+
+
 /** sets a widget's z-order
     @param wgt widget to set the z-order of; it must be a child widget
     @param z_order z-order to insert the child widget at; if 0, the child widget
@@ -1041,13 +1056,17 @@ AWE_GUI_UPDATE_MODE awe_get_gui_update_mode();
     @param mode the gui's update mode
     @param drs_proc optional dirty rectangle system procedure; if set, and the
            system draws changes only, it is called for each rectangle being
-           drawn. 
+           drawn. If the mouse is shown on the gui screen, the procedure should
+           present the rectangle with awe_present_mouse_area, so as that the
+           cursor is composited over it.
  */
 void awe_set_gui_update_mode(AWE_GUI_UPDATE_MODE mode, AWE_DRS_PROC drs_proc);
 
 
 /** updates the GUI. It draws either the changes or all widgets, according to
-    the update mode. The changes are drawn on the GUI screen.
+    the update mode. The changes are drawn on the GUI screen. Running
+    animations are advanced first, and all widgets are repainted if the
+    color depth of the GUI screen has changed.
  */
 void awe_update_gui();
 
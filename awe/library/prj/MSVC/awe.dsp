@@ -91,6 +91,10 @@ LINK32=link.exe
 # PROP Default_Filter ""
 # Begin Source File
 
+SOURCE=..\..\include\animation.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\include\com.h
 # End Source File
 # Begin Source File
@@ -131,6 +135,10 @@ SOURCE=..\..\include\linkedlist.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\include\loader.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\include\mouse.h
 # End Source File
 # Begin Source File
@@ -159,6 +167,10 @@ SOURCE=..\..\include\widget.h
 # PROP Default_Filter ""
 # Begin Source File
 
+SOURCE=..\..\src\animation.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\com.c
 # End Source File
 # Begin Source File
@@ -203,6 +215,14 @@ SOURCE=..\..\src\linkedlist.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\loader.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\..\src\loader_win32.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\mouse.c
 # End Source File
 # Begin Source File
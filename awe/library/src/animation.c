@@ -0,0 +1,241 @@
+#include "animation.h"
+
+
+/*****************************************************************************
+    PRIVATE
+ *****************************************************************************/
+
+
+//fixed point one of the animation progress
+#define _PROGRESS_ONE        1024
+
+
+//animation structure
+struct AWE_ANIMATION {
+    AWE_WIDGET *wgt;
+    int num_frames;
+    int duration;
+    AWE_ANIMATION_LOOP loop;
+    AWE_EASING easing;
+    unsigned start;
+    int frame;
+    int running;
+    int paused;
+    unsigned pause_time;
+    AWE_ANIMATION *next;
+};
+
+
+//variables
+static AWE_ANIMATION *_animations = 0;
+static int _running = 0;
+
+
+//eases a progress
+static int _ease(AWE_EASING easing, int p)
+{
+    int q = _PROGRESS_ONE - p;
+
+    switch (easing) {
+        case AWE_EASE_IN:
+            return p * p / _PROGRESS_ONE;
+
+        case AWE_EASE_OUT:
+            return _PROGRESS_ONE - q * q / _PROGRESS_ONE;
+
+        case AWE_EASE_IN_OUT:
+            if (p < _PROGRESS_ONE / 2) return 2 * p * p / _PROGRESS_ONE;
+            return _PROGRESS_ONE - 2 * q * q / _PROGRESS_ONE;
+
+        default:
+            return p;
+    }
+}
+
+
+//returns the frame of an animation at the given time; animations played once stop on their last frame
+static int _get_frame(AWE_ANIMATION *anim, unsigned time)
+{
+    unsigned t = time - anim->start;
+    int p, frame;
+
+    switch (anim->loop) {
+        case AWE_ANIMATION_ONCE:
+            if (t >= (unsigned)anim->duration) {
+                anim->running = FALSE;
+                _running--;
+                return anim->num_frames - 1;
+            }
+            break;
+
+        case AWE_ANIMATION_BACK:
+            t %= 2 * anim->duration;
+            if (t >= (unsigned)anim->duration) t = 2 * anim->duration - t;
+            break;
+
+        default:
+            t %= anim->duration;
+    }
+
+    p = _ease(anim->easing, (int)(t * _PROGRESS_ONE / anim->duration));
+    frame = p * anim->num_frames / _PROGRESS_ONE;
+    if (frame >= anim->num_frames) frame = anim->num_frames - 1;
+    return anim->loop == AWE_ANIMATION_REVERSE ? anim->num_frames - 1 - frame : frame;
+}
+
+
+/*****************************************************************************
+    PUBLIC
+ *****************************************************************************/
+
+
+//starts an animation
+AWE_ANIMATION *awe_start_animation(AWE_WIDGET *wgt, int num_frames, int duration, AWE_ANIMATION_LOOP loop, AWE_EASING easing)
+{
+    AWE_ANIMATION *anim;
+
+    if (num_frames < 1 || duration < 1) return 0;
+    anim = (AWE_ANIMATION *)malloc(sizeof(AWE_ANIMATION));
+    if (!anim) return 0;
+    anim->wgt = wgt;
+    anim->num_frames = num_frames;
+    anim->duration = duration;
+    anim->loop = loop;
+    anim->easing = easing;
+    anim->start = awe_get_input_time();
+    anim->frame = loop == AWE_ANIMATION_REVERSE ? num_frames - 1 : 0;
+    anim->running = num_frames > 1;
+    anim->paused = FALSE;
+    anim->next = _animations;
+    _animations = anim;
+    if (anim->running) _running++;
+    return anim;
+}
+
+
+//starts an animation described by a skin
+AWE_ANIMATION *awe_start_skin_animation(AWE_WIDGET *wgt, const AWE_SKIN_ANIM *anim, AWE_EASING easing)
+{
+    AWE_ANIMATION_LOOP loop;
+
+    switch (anim->type) {
+        case AWE_SKIN_ANIM_LOOP_FORWARD:
+            loop = AWE_ANIMATION_REPEAT;
+            break;
+
+        case AWE_SKIN_ANIM_LOOP_REVERSE:
+            loop = AWE_ANIMATION_REVERSE;
+            break;
+
+        case AWE_SKIN_ANIM_LOOP_ONCE:
+            loop = AWE_ANIMATION_ONCE;
+            break;
+
+        default:
+            return 0;
+    }
+    return awe_start_animation(wgt, anim->numframes, anim->numframes * anim->speed, loop, easing);
+}
+
+
+//stops an animation
+void awe_stop_animation(AWE_ANIMATION *anim)
+{
+    AWE_ANIMATION **prev;
+
+    for(prev = &_animations; *prev; prev = &(*prev)->next) {
+        if (*prev == anim) {
+            *prev = anim->next;
+            if (anim->running) _running--;
+            free(anim);
+            return;
+        }
+    }
+}
+
+
+//stops the animations of a widget and its descentants
+void awe_stop_widget_animations(AWE_WIDGET *wgt)
+{
+    AWE_ANIMATION **prev, *anim;
+
+    for(prev = &_animations; (anim = *prev); ) {
+        if (anim->wgt == wgt || awe_is_ancestor_widget(wgt, anim->wgt)) {
+            *prev = anim->next;
+            if (anim->running) _running--;
+            free(anim);
+            continue;
+        }
+        prev = &anim->next;
+    }
+}
+
+
+//pauses the animations of a widget and its descentants
+void awe_pause_widget_animations(AWE_WIDGET *wgt)
+{
+    AWE_ANIMATION *anim;
+
+    for(anim = _animations; anim; anim = anim->next) {
+        if (!anim->running) continue;
+        if (anim->wgt != wgt && !awe_is_ancestor_widget(wgt, anim->wgt)) continue;
+        anim->running = FALSE;
+        anim->paused = TRUE;
+        anim->pause_time = awe_get_input_time();
+        _running--;
+    }
+}
+
+
+//resumes the paused animations of a widget and its descentants
+void awe_resume_widget_animations(AWE_WIDGET *wgt)
+{
+    AWE_ANIMATION *anim;
+
+    for(anim = _animations; anim; anim = anim->next) {
+        if (!anim->paused) continue;
+        if (anim->wgt != wgt && !awe_is_ancestor_widget(wgt, anim->wgt)) continue;
+
+        //the animation goes on from the frame it was paused at
+        anim->start += awe_get_input_time() - anim->pause_time;
+        anim->running = TRUE;
+        anim->paused = FALSE;
+        _running++;
+    }
+}
+
+
+//returns the current frame of an animation
+int awe_get_animation_frame(const AWE_ANIMATION *anim)
+{
+    return anim->frame;
+}
+
+
+//returns true if an animation is running
+int awe_is_animation_running(const AWE_ANIMATION *anim)
+{
+    return anim->running;
+}
+
+
+//advances the running animations
+int awe_update_animations()
+{
+    AWE_ANIMATION *anim;
+    unsigned time;
+    int frame;
+
+    //idle screens do no work
+    if (!_running) return 0;
+
+    time = awe_get_input_time();
+    for(anim = _animations; anim; anim = anim->next) {
+        if (!anim->running) continue;
+        frame = _get_frame(anim, time);
+        if (frame == anim->frame) continue;
+        anim->frame = frame;
+        awe_set_widget_dirty(anim->wgt);
+    }
+    return _running;
+}
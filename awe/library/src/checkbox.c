@@ -73,6 +73,7 @@ static void _checkbox_get_background(AWE_OBJECT *obj, void *data)
 static void _checkbox_set_background(AWE_OBJECT *obj, void *data)
 {
     ((AWE_CHECKBOX *)obj)->bg = *(RGB *)data;
+    ((AWE_PUSH_BUTTON *)obj)->color_version = 0;
     awe_set_widget_dirty((AWE_WIDGET *)obj);
 }
 
@@ -139,7 +140,8 @@ AWE_PUSH_BUTTON_VTABLE awe_checkbox_vtable = {
     ,
     //control
     {
-        awe_push_button_key_press
+        awe_push_button_key_press,
+        awe_push_button_get_hot_key
     }
     ,
     //geometry
@@ -175,16 +177,26 @@ AWE_OBJECT *awe_checkbox_clone(AWE_OBJECT *wgt)
 }
 
 
+//makes the pixel values of the colors
+int awe_checkbox_make_colors(AWE_CHECKBOX *chk)
+{
+    if (!awe_push_button_make_colors((AWE_PUSH_BUTTON *)chk)) return 0;
+    chk->bg_pix = AWE_MAKE_COLOR(chk->bg);
+    return 1;
+}
+
+
 //checkbox paint
 void awe_checkbox_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *clip)
 {
     AWE_PUSH_BUTTON *btn = (AWE_PUSH_BUTTON *)wgt;
     int state = 0;
-    int tx = ((AWE_CHECKBOX *)wgt)->text_dir ? wgt->height + 5 : wgt->width - wgt->height - text_length(btn->font, btn->text) - 5;
-    int ty = (wgt->height - text_height(btn->font)) >> 1;
+    int tx = ((AWE_CHECKBOX *)wgt)->text_dir ? wgt->height + 5 : wgt->width - wgt->height - btn->text_width - 5;
+    int ty = (wgt->height - btn->text_height) >> 1;
     int cx = ((AWE_CHECKBOX *)wgt)->text_dir ? 0 : wgt->width - wgt->height;
 
     solid_mode();
+    awe_checkbox_make_colors((AWE_CHECKBOX *)wgt);
     
     if(!awe_is_enabled_widget_tree(wgt))
         state = AWE_PUSH_BUTTON_TEXTURE_DISABLED;
@@ -196,30 +208,30 @@ void awe_checkbox_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *cli
         state = AWE_PUSH_BUTTON_TEXTURE_ENABLED;
 
     awe_fill_gradient_s(canvas, cx + 2, 2, wgt->height - 4, wgt->height - 4, 
-        AWE_MAKE_COLOR(btn->texture[state].face_col[AWE_PUSH_BUTTON_FACE_TOP_LEFT]),
-        AWE_MAKE_COLOR(btn->texture[state].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_LEFT]),
-        AWE_MAKE_COLOR(btn->texture[state].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_RIGHT]),
-        AWE_MAKE_COLOR(btn->texture[state].face_col[AWE_PUSH_BUTTON_FACE_TOP_RIGHT]));
+        btn->texture[state].face_pix[AWE_PUSH_BUTTON_FACE_TOP_LEFT],
+        btn->texture[state].face_pix[AWE_PUSH_BUTTON_FACE_BOTTOM_LEFT],
+        btn->texture[state].face_pix[AWE_PUSH_BUTTON_FACE_BOTTOM_RIGHT],
+        btn->texture[state].face_pix[AWE_PUSH_BUTTON_FACE_TOP_RIGHT]);
 
     awe_draw_3d_rect_s(canvas, cx, 0, wgt->height, wgt->height, 
-        AWE_MAKE_COLOR(btn->texture[state].edge_col[AWE_PUSH_BUTTON_EDGE_TOP_LEFT]),
-        AWE_MAKE_COLOR(btn->texture[state].edge_col[AWE_PUSH_BUTTON_EDGE_BOTTOM_RIGHT]), 
+        btn->texture[state].edge_pix[AWE_PUSH_BUTTON_EDGE_TOP_LEFT],
+        btn->texture[state].edge_pix[AWE_PUSH_BUTTON_EDGE_BOTTOM_RIGHT], 
         2);
 
     awe_fill_rect_s(canvas, ((AWE_CHECKBOX *)wgt)->text_dir ? wgt->height + 3 : 0, 
-        0, wgt->width - wgt->height - 3, wgt->height, AWE_MAKE_COLOR(((AWE_CHECKBOX *)wgt)->bg));
+        0, wgt->width - wgt->height - 3, wgt->height, ((AWE_CHECKBOX *)wgt)->bg_pix);
 
     if(((AWE_TOGGLE_BUTTON *)wgt)->toggle)
-        awe_draw_tick_icon(canvas, cx + (wgt->height >> 1), wgt->height >> 1, (wgt->height >> 1) - 3, AWE_MAKE_COLOR(btn->texture[state].font_col), 3);
+        awe_draw_tick_icon(canvas, cx + (wgt->height >> 1), wgt->height >> 1, (wgt->height >> 1) - 3, btn->texture[state].font_pix, 3);
 
-    if(AWE_MAKE_COLOR(btn->texture[state].font_sdw) != makecol(255, 0, 255))
-        awe_draw_gui_text(canvas, btn->font, btn->text, tx + 1, ty + 1, AWE_MAKE_COLOR(btn->texture[state].font_sdw), -1);
+    if(btn->texture[state].sdw_pix != -1)
+        awe_draw_gui_text(canvas, btn->font, btn->text, tx + 1, ty + 1, btn->texture[state].sdw_pix, -1);
 
-    awe_draw_gui_text(canvas, btn->font, btn->text, tx, ty, AWE_MAKE_COLOR(btn->texture[state].font_col), -1);
+    awe_draw_gui_text(canvas, btn->font, btn->text, tx, ty, btn->texture[state].font_pix, -1);
 
     if (awe_get_focus_widget() == wgt && state != AWE_PUSH_BUTTON_TEXTURE_DISABLED)
         awe_draw_rect_pattern_s(canvas, ((AWE_CHECKBOX *)wgt)->text_dir ? wgt->height + 3 : 0, 
-            0, wgt->width - wgt->height - 3, wgt->height, AWE_MAKE_COLOR(btn->texture[state].font_col), AWE_PATTERN_DOT_DOT);
+            0, wgt->width - wgt->height - 3, wgt->height, btn->texture[state].font_pix, AWE_PATTERN_DOT_DOT);
 }
 
 
@@ -260,7 +272,7 @@ void awe_checkbox_timer(AWE_WIDGET *wgt, const AWE_EVENT *event)
 
 void awe_checkbox_set_geometry(AWE_WIDGET *wgt)
 {
-    int height = MAX(13, text_height(((AWE_PUSH_BUTTON *)wgt)->font));
-    int width = text_length(((AWE_PUSH_BUTTON *)wgt)->font, ((AWE_PUSH_BUTTON *)wgt)->text) + height + 5;
+    int height = MAX(13, ((AWE_PUSH_BUTTON *)wgt)->text_height);
+    int width = ((AWE_PUSH_BUTTON *)wgt)->text_width + height + 5;
     awe_override_widget_size(wgt, width, height);
 }
@@ -6,11 +6,76 @@
  *****************************************************************************/
 
 
-//dispatches the control.key_press message to all descentants of given widget
-static int _dispatch_control_key_press(AWE_WIDGET *wgt, const AWE_EVENT *event)
+//number of hot key index buckets; must be a power of 2
+#define _HOT_KEY_BUCKETS     64
+
+
+//number of dialogs that indices are kept for
+#define _DIALOG_INDICES      4
+
+
+//hot key index entry
+typedef struct _HOT_KEY_ENTRY {
+    AWE_WIDGET *wgt;
+    AWE_CONTROL_VTABLE *control;
+    int key;
+    int next;
+} _HOT_KEY_ENTRY;
+
+
+/* indices of a dialog:
+   hot key entries are in dispatch order, and chained per bucket; controls
+   without a hot key are chained separately.
+   the focus chain is the dialog followed by its descentants in tab order.
+ */
+typedef struct _DIALOG_INDEX {
+    AWE_WIDGET *dialog;
+    unsigned hot_key_tree_version;
+    unsigned hot_key_version;
+    _HOT_KEY_ENTRY *entry;
+    int entry_count;
+    int entry_size;
+    int bucket[_HOT_KEY_BUCKETS];
+    int any;
+    unsigned focus_tree_version;
+    AWE_WIDGET **focus;
+    int focus_count;
+    int focus_size;
+    int focus_pos;
+} _DIALOG_INDEX;
+
+
+//variables
+static _DIALOG_INDEX _dialog_index[_DIALOG_INDICES];
+static int _next_dialog_index = 0;
+static unsigned _hot_key_version = 0;
+
+
+//returns the index slot of a dialog; the indices of an evicted dialog are invalidated
+static _DIALOG_INDEX *_get_dialog_index(AWE_WIDGET *dialog)
+{
+    _DIALOG_INDEX *index;
+    int i;
+
+    for(i = 0; i < _DIALOG_INDICES; i++) {
+        if (_dialog_index[i].dialog == dialog) return _dialog_index + i;
+    }
+    index = _dialog_index + _next_dialog_index;
+    _next_dialog_index = (_next_dialog_index + 1) % _DIALOG_INDICES;
+    index->dialog = dialog;
+    index->hot_key_tree_version = awe_get_widget_tree_version() - 1;
+    index->focus_tree_version = awe_get_widget_tree_version() - 1;
+    return index;
+}
+
+
+//adds the control descentants of the given widget to a hot key index
+static void _add_hot_key_entries(_DIALOG_INDEX *index, AWE_WIDGET *wgt)
 {
     AWE_CONTROL_VTABLE *control;
     AWE_WIDGET *child;
+    _HOT_KEY_ENTRY *entry;
+    int key;
 
     for(child = awe_get_first_child_widget(wgt);
         child;
@@ -18,111 +83,202 @@ static int _dispatch_control_key_press(AWE_WIDGET *wgt, const AWE_EVENT *event)
         control = (AWE_CONTROL_VTABLE *)awe_get_widget_interface(child, 
             AWE_ID_CONTROL,
             AWE_ID_AWE);
-        if (control && control->key_press(child, event)) return 1;
-        if (_dispatch_control_key_press(child, event)) return 1;
+        if (control) {
+            key = control->get_hot_key ? control->get_hot_key(child) : -1;
+            if (key && index->entry_count == index->entry_size) {
+                entry = (_HOT_KEY_ENTRY *)realloc(index->entry, (index->entry_size * 2 + 16) * sizeof(_HOT_KEY_ENTRY));
+                if (!entry) return;
+                index->entry = entry;
+                index->entry_size = index->entry_size * 2 + 16;
+            }
+            if (key) {
+                entry = index->entry + index->entry_count++;
+                entry->wgt = child;
+                entry->control = control;
+                entry->key = key;
+            }
+        }
+        _add_hot_key_entries(index, child);
     }
-    return 0;
 }
 
 
-//returns topmost descentant
-static AWE_WIDGET *_get_top(AWE_WIDGET *wgt)
+//returns the up-to-date hot key index of a dialog
+static _DIALOG_INDEX *_get_hot_key_index(AWE_WIDGET *dialog)
 {
-    while (1) {
-        AWE_WIDGET *child = awe_get_last_child_widget(wgt);
-        if (!child) return wgt;
-        wgt = child;
+    _DIALOG_INDEX *index = _get_dialog_index(dialog);
+    _HOT_KEY_ENTRY *entry;
+    int i, *head;
+
+    if (index->hot_key_tree_version == awe_get_widget_tree_version() &&
+        index->hot_key_version == _hot_key_version)
+        return index;
+
+    index->hot_key_tree_version = awe_get_widget_tree_version();
+    index->hot_key_version = _hot_key_version;
+    index->entry_count = 0;
+    _add_hot_key_entries(index, dialog);
+
+    //chain entries; walk backwards so as that chains are in dispatch order
+    for(i = 0; i < _HOT_KEY_BUCKETS; i++) index->bucket[i] = -1;
+    index->any = -1;
+    for(i = index->entry_count - 1; i >= 0; i--) {
+        entry = index->entry + i;
+        head = entry->key < 0 ? &index->any : &index->bucket[entry->key & (_HOT_KEY_BUCKETS - 1)];
+        entry->next = *head;
+        *head = i;
     }
-    return wgt;
+    return index;
 }
 
 
-//returns the previous widget as if widgets were a flat list
-static AWE_WIDGET *_get_prev(AWE_WIDGET *wgt)
+//dispatches the control.key_press message to the descentants of given widget
+//that have a matching hot key or no hot key at all
+static int _dispatch_control_key_press(AWE_WIDGET *wgt, const AWE_EVENT *event)
 {
-    AWE_WIDGET *prev = awe_get_prev_sibling_widget(wgt);
-    if (prev) return _get_top(prev);
-    return awe_get_parent_widget(wgt);
+    _DIALOG_INDEX *index = _get_hot_key_index(wgt);
+    _HOT_KEY_ENTRY *entry;
+    int key = utolower(event->key.key);
+    int k = index->bucket[key & (_HOT_KEY_BUCKETS - 1)];
+    int a = index->any;
+
+    //merge the two chains, keeping dispatch order
+    while (k >= 0 || a >= 0) {
+        if (a < 0 || (k >= 0 && k < a)) {
+            entry = index->entry + k;
+            k = entry->next;
+            if (entry->key != key) continue;
+        }
+        else {
+            entry = index->entry + a;
+            a = entry->next;
+        }
+        if (entry->control->key_press(entry->wgt, event)) return 1;
+    }
+    return 0;
 }
 
 
-//returns the next widget as if widgets were a flat list
-static AWE_WIDGET *_get_next(AWE_WIDGET *wgt)
+//adds a widget and its descentants to the focus chain, in tree order
+static int _add_focus_widgets(_DIALOG_INDEX *index, AWE_WIDGET *wgt)
 {
-    AWE_WIDGET *t = awe_get_first_child_widget(wgt);
-    if (t) return t;
-    for(; wgt; wgt = awe_get_parent_widget(wgt)) {
-        t = awe_get_next_sibling_widget(wgt);
-        if (t) return t;
+    AWE_WIDGET **focus, *child;
+
+    if (index->focus_count == index->focus_size) {
+        focus = (AWE_WIDGET **)realloc(index->focus, (index->focus_size * 2 + 16) * sizeof(AWE_WIDGET *));
+        if (!focus) return 0;
+        index->focus = focus;
+        index->focus_size = index->focus_size * 2 + 16;
     }
-    return 0;
+    index->focus[index->focus_count++] = wgt;
+
+    for(child = awe_get_first_child_widget(wgt);
+        child;
+        child = awe_get_next_sibling_widget(child)) {
+        if (!_add_focus_widgets(index, child)) return 0;
+    }
+    return 1;
 }
 
 
-//actual moving of the focus; the widget tree is flattened
-static void _move_focus(AWE_WIDGET *begin,
-                        AWE_WIDGET *end, 
-                        AWE_WIDGET *restart,
-                        AWE_WIDGET *(*next)(AWE_WIDGET *))
+//returns the up-to-date focus chain of a dialog
+static _DIALOG_INDEX *_get_focus_chain(AWE_WIDGET *dialog)
 {
-    AWE_WIDGET *wgt;
+    _DIALOG_INDEX *index = _get_dialog_index(dialog);
+    AWE_WIDGET *wgt, *prev;
+    int i, j;
+
+    if (index->focus_tree_version == awe_get_widget_tree_version()) return index;
 
-    //try until end
-    for(wgt = begin; wgt != end; wgt = next(wgt)) {
-        if (awe_set_focus_widget(wgt)) return;
+    index->focus_tree_version = awe_get_widget_tree_version();
+    index->focus_count = 0;
+    index->focus_pos = 0;
+    if (!_add_focus_widgets(index, dialog)) {
+        index->focus_count = 0;
+        return index;
+    }
+
+    /* move widgets with a tab order right after the dialog; insertion sort
+       keeps the tree order of widgets with the same tab order
+     */
+    for(i = 1; i < index->focus_count; i++) {
+        wgt = index->focus[i];
+        if (wgt->tab_order <= 0) continue;
+        for(j = i; j > 1; j--) {
+            prev = index->focus[j - 1];
+            if (prev->tab_order > 0 && prev->tab_order <= wgt->tab_order) break;
+            index->focus[j] = prev;
+        }
+        index->focus[j] = wgt;
     }
+    return index;
+}
+
+
+//returns the position of a widget in the focus chain or -1 if not found
+static int _find_focus_pos(_DIALOG_INDEX *index, AWE_WIDGET *wgt)
+{
+    int i;
 
-    //recycle
-    for(wgt = restart; wgt != begin; wgt = next(wgt)) {
-        if (awe_set_focus_widget(wgt)) return;
+    //the last focus widget set through the chain is checked first
+    if (index->focus_pos < index->focus_count && index->focus[index->focus_pos] == wgt) return index->focus_pos;
+    for(i = 0; i < index->focus_count; i++) {
+        if (index->focus[i] == wgt) return i;
     }
+    return -1;
 }
 
 
 //moves the dialog focus
 static void _move_dialog_focus(AWE_WIDGET *wgt, const AWE_EVENT *event)
 {
-    AWE_WIDGET *focus_wgt, *begin, *end, *restart;
-    AWE_WIDGET *(*next_proc)(AWE_WIDGET *) = 0;
+    _DIALOG_INDEX *index;
+    AWE_WIDGET *focus_wgt, *candidate;
+    int dir, pos, i;
 
     //find direction to move the focus
     switch (event->key.scancode) {
         case KEY_LEFT:
         case KEY_UP:
-            next_proc = _get_prev;
+            dir = -1;
             break;
 
         case KEY_RIGHT:
         case KEY_DOWN:
-            next_proc = _get_next;
+            dir = 1;
             break;
 
         case KEY_TAB:
-            next_proc = (event->key.shifts & KB_SHIFT_FLAG) ? _get_prev : _get_next;
+            dir = (event->key.shifts & KB_SHIFT_FLAG) ? -1 : 1;
             break;
 
         default:
             return;
     }
-    
+
+    index = _get_focus_chain(wgt);
+    if (!index->focus_count) return;
+
     /* move the focus away from the current focus widget; if the focus not
        inside the dialog, then move the focus as if no focus widget exists.
      */
     focus_wgt = awe_get_focus_widget();
-    if (focus_wgt && !awe_is_ancestor_widget(wgt, focus_wgt)) focus_wgt = 0;
+    pos = focus_wgt ? _find_focus_pos(index, focus_wgt) : -1;
+    if (pos < 0) pos = dir > 0 ? index->focus_count - 1 : 0;
 
-    //move the focus according to selected direction
-    if (next_proc == _get_next) {
-        restart = wgt;
-        begin = focus_wgt ? _get_next(focus_wgt) : wgt;
-        end = _get_next(_get_top(wgt));
-    }
-    else {
-        restart = _get_top(wgt);
-        begin = focus_wgt ? _get_prev(focus_wgt) : restart;
-        end = _get_prev(wgt);
+    /* try the widgets after the focus widget, recycling; widgets that can
+       not get the focus are skipped without calling them
+     */
+    for(i = 0; i < index->focus_count; i++) {
+        pos += dir;
+        if (pos == index->focus_count) pos = 0; else if (pos < 0) pos = index->focus_count - 1;
+        candidate = index->focus[pos];
+        if (!candidate->on_screen || !candidate->enabled_tree) continue;
+        if (awe_set_focus_widget(candidate)) {
+            index->focus_pos = pos;
+            return;
+        }
     }
-    _move_focus(begin, end, restart, next_proc);
 }
 
 
@@ -137,3 +293,10 @@ void awe_dialog_key_down(AWE_WIDGET *wgt, const AWE_EVENT *event)
     if (_dispatch_control_key_press(wgt, event)) return;
     _move_dialog_focus(wgt, event);
 }
+
+
+//notifies the dialogs that the hot key of a control has changed
+void awe_control_hot_key_changed(AWE_WIDGET *wgt)
+{
+    _hot_key_version++;
+}
@@ -1,4 +1,5 @@
 #include "event.h"
+#include "loader.h"
 
 
 /*****************************************************************************
@@ -25,33 +26,57 @@
 }
 
 
+//number of event modes the stack grows by
+#define _EVENT_MODES_GROW    16
+
+
+//number of procs an event mode grows by
+#define _EVENT_PROCS_GROW    8
+
+
+//number of event types
+#define _EVENT_TYPES         (AWE_EVENT_LOAD + 1)
+
+
 //event proc
 typedef struct _EVENT_PROC {
-    AWE_DL_NODE node;
     AWE_EVENT_PROC proc;
     void *data;
+    int types;
 } _EVENT_PROC;
 
 
-//event mode
+//event mode; procs are kept in registration order, and each event type has
+//its own table of indices to the procs that are interested in it
 typedef struct _EVENT_MODE {
-    AWE_DL_NODE node;
-    AWE_DL_LIST procs;
+    _EVENT_PROC *procs;
+    int proc_count;
+    int proc_size;
+    int *table[_EVENT_TYPES];
+    int table_count[_EVENT_TYPES];
     int processed:1;
     int removed:1;
 } _EVENT_MODE;
 
 
-//variables
-static AWE_DL_LIST _event_mode_stack = {0, 0};
+//variables; modes are allocated one by one, so as that they keep their
+//address while the stack grows, and left modes are kept above the top of
+//the stack to be entered again without allocating
+static _EVENT_MODE **_event_mode_stack = 0;
+static int _event_mode_count = 0;
+static int _event_mode_size = 0;
 static int _last_x = INT_MIN;
 static int _last_y = INT_MIN;
 
 
+//returns the current event mode
+#define _CURRENT_MODE() (_event_mode_count ? _event_mode_stack[_event_mode_count - 1] : 0)
+
+
 //installs the stuff
 static void _install()
 {
-    if (_event_mode_stack.first) return;
+    if (_event_mode_count) return;
     awe_enter_event_mode(awe_def_event_proc, 0);
 }
 
@@ -59,36 +84,69 @@ static void _install()
 //finds an event proc
 static _EVENT_PROC *_find_event_proc(_EVENT_MODE *mode, AWE_EVENT_PROC proc_, void *data)
 {
-    _EVENT_PROC *proc = (_EVENT_PROC *)mode->procs.first;
+    _EVENT_PROC *proc;
 
-    for(; proc; proc = (_EVENT_PROC *)proc->node.next) {
+    for(proc = mode->procs; proc < mode->procs + mode->proc_count; proc++) {
         if (proc->proc == proc_ && proc->data == data) return proc;
     }
     return 0;
 }
 
 
+//makes room for one more proc in a mode; the tables are rebuilt afterwards
+static int _grow_event_mode(_EVENT_MODE *mode)
+{
+    _EVENT_PROC *procs;
+    int *tables, size, type;
+
+    if (mode->proc_count < mode->proc_size) return 1;
+    size = mode->proc_size + _EVENT_PROCS_GROW;
+    procs = (_EVENT_PROC *)realloc(mode->procs, size * sizeof(_EVENT_PROC));
+    if (!procs) return 0;
+    mode->procs = procs;
+    tables = (int *)realloc(mode->table[0], size * _EVENT_TYPES * sizeof(int));
+    if (!tables) return 0;
+    for(type = 0; type < _EVENT_TYPES; type++) {
+        mode->table[type] = tables + type * size;
+    }
+    mode->proc_size = size;
+    return 1;
+}
+
+
+//rebuilds the per event type tables of a mode
+static void _build_event_tables(_EVENT_MODE *mode)
+{
+    int type, i;
+
+    for(type = 0; type < _EVENT_TYPES; type++) {
+        mode->table_count[type] = 0;
+        for(i = 0; i < mode->proc_count; i++) {
+            if (mode->procs[i].types & AWE_EVENT_MASK(type)) {
+                mode->table[type][mode->table_count[type]++] = i;
+            }
+        }
+    }
+}
+
+
 //deletes an event mode
 static void _delete_event_mode(_EVENT_MODE *mode)
 {
-    AWE_DL_NODE *node, *next;
+    _EVENT_PROC *proc;
+    int i;
 
     //call all procs
-    for(node = mode->procs.first; node; node = node->next) {
-        ((_EVENT_PROC *)node)->proc(AWE_EVENT_MODE_ACTION_END, 0, ((_EVENT_PROC *)node)->data);
-    }
-
-    //free procs
-    node = mode->procs.first;
-    while (node) {
-        next = node->next;
-        free(node);
-        node = next;
+    for(proc = mode->procs; proc < mode->procs + mode->proc_count; proc++) {
+        proc->proc(AWE_EVENT_MODE_ACTION_END, 0, proc->data);
     }
 
-    //remove and free mode
-    awe_list_remove(&_event_mode_stack, &mode->node);
-    free(mode);
+    //remove mode; modes entered after it are moved down
+    for(i = 0; _event_mode_stack[i] != mode; i++)
+        ;
+    _event_mode_count--;
+    memmove(_event_mode_stack + i, _event_mode_stack + i + 1, (_event_mode_count - i) * sizeof(_EVENT_MODE *));
+    _event_mode_stack[_event_mode_count] = mode;
 }
 
 
@@ -210,6 +268,10 @@ static int _do_event(AWE_WIDGET *root, AWE_EVENT *event, int force)
         case AWE_EVENT_TIMER:
             return _do_timer_event(event);
 
+        //load events are finished by awe_do_events
+        case AWE_EVENT_LOAD:
+            return 0;
+
         //no event
         case AWE_EVENT_NONE:
             return 0;
@@ -225,7 +287,14 @@ static int _do_event(AWE_WIDGET *root, AWE_EVENT *event, int force)
 
 
 //registers an event procedure in the current event mode
-void awe_add_event_proc(AWE_EVENT_PROC proc_, void *data)
+void awe_add_event_proc(AWE_EVENT_PROC proc, void *data)
+{
+    awe_add_event_proc_ex(proc, data, AWE_EVENT_MASK_ALL);
+}
+
+
+//registers an event procedure in the current event mode for some event types
+void awe_add_event_proc_ex(AWE_EVENT_PROC proc_, void *data, int types)
 {
     _EVENT_MODE *mode;
     _EVENT_PROC *proc;
@@ -234,16 +303,20 @@ void awe_add_event_proc(AWE_EVENT_PROC proc_, void *data)
     _install();
 
     //do not re-install proc if it already exists
-    mode = (_EVENT_MODE *)_event_mode_stack.last;
+    mode = _CURRENT_MODE();
     proc = _find_event_proc(mode, proc_, data);
     if (proc) return;
 
     //install new proc
-    proc = (_EVENT_PROC *)calloc(1, sizeof(_EVENT_PROC));
-    if (!proc) return;
-    awe_list_insert(&mode->procs, &proc->node, 0);
+    if (!_grow_event_mode(mode)) {
+        TRACE("Event: Out of memory adding an event proc\n");
+        return;
+    }
+    proc = mode->procs + mode->proc_count++;
     proc->proc = proc_;
     proc->data = data;
+    proc->types = types;
+    _build_event_tables(mode);
 
     //notify proc
     proc_(AWE_EVENT_MODE_ACTION_BEGIN, 0, data);
@@ -257,11 +330,11 @@ void awe_replace_event_proc(AWE_EVENT_PROC new_proc, AWE_EVENT_PROC old_proc)
     _EVENT_PROC *proc;
 
     //get current mode
-    mode = (_EVENT_MODE *)_event_mode_stack.last;
+    mode = _CURRENT_MODE();
     if (!mode) return;
 
     //set proc
-    for(proc = (_EVENT_PROC *)mode->procs.first; proc; proc = (_EVENT_PROC *)proc->node.next) {
+    for(proc = mode->procs; proc < mode->procs + mode->proc_count; proc++) {
         if (proc->proc == old_proc) {
             proc->proc(AWE_EVENT_MODE_ACTION_END, 0, proc->data);
             proc->proc = new_proc;
@@ -278,7 +351,7 @@ void awe_remove_event_proc(AWE_EVENT_PROC proc_, void *data)
     _EVENT_PROC *proc;
 
     //get current mode
-    mode = (_EVENT_MODE *)_event_mode_stack.last;
+    mode = _CURRENT_MODE();
     if (!mode) return;
 
     //find proc
@@ -286,8 +359,9 @@ void awe_remove_event_proc(AWE_EVENT_PROC proc_, void *data)
     if (!proc) return;
 
     //remove proc
-    awe_list_remove(&mode->procs, &proc->node);
-    free(proc);
+    mode->proc_count--;
+    memmove(proc, proc + 1, (char *)(mode->procs + mode->proc_count) - (char *)proc);
+    _build_event_tables(mode);
 
     //notify proc
     proc_(AWE_EVENT_MODE_ACTION_END, 0, data);
@@ -297,14 +371,37 @@ void awe_remove_event_proc(AWE_EVENT_PROC proc_, void *data)
 //enters a new event mode
 void awe_enter_event_mode(AWE_EVENT_PROC proc, void *data)
 {
-    _EVENT_MODE *mode;
+    _EVENT_MODE *mode, **stack;
+
+    //grow the stack, if needed
+    if (_event_mode_count == _event_mode_size) {
+        stack = (_EVENT_MODE **)realloc(_event_mode_stack, (_event_mode_size + _EVENT_MODES_GROW) * sizeof(_EVENT_MODE *));
+        if (!stack) {
+            TRACE("Event: Out of memory entering an event mode\n");
+            return;
+        }
+        memset(stack + _event_mode_size, 0, _EVENT_MODES_GROW * sizeof(_EVENT_MODE *));
+        _event_mode_stack = stack;
+        _event_mode_size += _EVENT_MODES_GROW;
+    }
 
-    //create a mode
-    mode = (_EVENT_MODE *)calloc(1, sizeof(_EVENT_MODE));
-    if (!mode) return;
+    //push a mode left before, or a new one
+    mode = _event_mode_stack[_event_mode_count];
+    if (!mode) {
+        mode = (_EVENT_MODE *)calloc(1, sizeof(_EVENT_MODE));
+        if (!mode) {
+            TRACE("Event: Out of memory entering an event mode\n");
+            return;
+        }
+        _event_mode_stack[_event_mode_count] = mode;
+    }
+    mode->proc_count = 0;
+    memset(mode->table_count, 0, sizeof(mode->table_count));
+    mode->processed = 0;
+    mode->removed = 0;
+    _event_mode_count++;
 
-    //add mode and register the given proc
-    awe_list_insert(&_event_mode_stack, &mode->node, 0);
+    //register the given proc
     if (proc) awe_add_event_proc(proc, data);
 }
 
@@ -312,10 +409,10 @@ void awe_enter_event_mode(AWE_EVENT_PROC proc, void *data)
 //leaves the current event mode
 void awe_leave_event_mode()
 {
-    _EVENT_MODE *mode = (_EVENT_MODE *)_event_mode_stack.last;
+    _EVENT_MODE *mode = _CURRENT_MODE();
 
     //make sure the first mode is not removed
-    if (!mode || !mode->node.prev) return;
+    if (!mode || mode == _event_mode_stack[0]) return;
 
     //free the mode (later if it is being processed)
     if (!mode->processed) _delete_event_mode(mode); else mode->removed = 1;
@@ -328,6 +425,7 @@ void awe_do_events()
     _EVENT_MODE *mode;
     _EVENT_PROC *proc;
     AWE_EVENT event;
+    int i;
 
     //install first mode, if needed
     _install();
@@ -335,11 +433,18 @@ void awe_do_events()
     //get input event
     if (!awe_get_event(&event)) return;
 
-    //call all procedures of current mode
-    mode = (_EVENT_MODE *)_event_mode_stack.last;
+    //finished loads are completed here, on the gui thread, whatever the mode
+    if (event.type == AWE_EVENT_LOAD) {
+        awe_finish_load((AWE_LOAD *)event.load.load);
+        return;
+    }
+
+    //call the procedures of current mode that are interested in the event
+    mode = _CURRENT_MODE();
     if (!mode) return;
     mode->processed = 1;
-    for(proc = (_EVENT_PROC *)mode->procs.first; proc; proc = (_EVENT_PROC *)proc->node.next) {
+    for(i = 0; i < mode->table_count[event.type]; i++) {
+        proc = mode->procs + mode->table[event.type][i];
         if (proc->proc(AWE_EVENT_MODE_ACTION_DO, &event, proc->data)) break;
     }
     mode->processed = 0;
@@ -432,6 +537,10 @@ int awe_grab_event_proc(AWE_EVENT_MODE_ACTION_TYPE action, AWE_EVENT *event, voi
         case AWE_EVENT_TIMER:
             return _do_timer_event(event);
 
+        //load events are finished by awe_do_events
+        case AWE_EVENT_LOAD:
+            return 0;
+
         //no event
         case AWE_EVENT_NONE:
             return 0;
@@ -1,4 +1,5 @@
 #include "font.h"
+#include "gdi.h"
 
 
 /*****************************************************************************
@@ -13,45 +14,503 @@ static int _font_install_count = 0;
 #ifdef TTFONT
 
 
-//font entry structure
-typedef struct _font_entry {
+//number of font hash buckets; must be a power of 2
+#define _FONT_BUCKETS        64
+
+
+/* font face structure; a face is loaded once per font file or memory font
+   and shared by all sizes of it. a font file may have been read into memory
+   by the caller, in which case the face owns the data.
+ */
+typedef struct _font_face {
     char *path;
+    const char *data;
+    int data_len;
+    ALFONT_FONT *alfont;
+    int size;
+    int memory;
+    int entry_count;
+    struct _font_face *next;
+} _FONT_FACE;
+
+
+//font entry structure; there is one entry per face and size
+typedef struct _font_entry {
+    _FONT_FACE *face;
     FONT *font;
     int size;
     int counter;
+    int memory;
+    unsigned used;
     struct _font_entry *next;
 } _FONT_ENTRY;
 
 
-//list of loaded fonts
-static _FONT_ENTRY *first_entry = NULL;
+//loaded fonts, hashed by face and size
+static _FONT_ENTRY *_font_bucket[_FONT_BUCKETS];
+
+
+//list of loaded faces
+static _FONT_FACE *first_face = NULL;
+
+
+//memory that may be kept by unused fonts
+static int _font_budget = 0;
+
+
+//unused font clock
+static unsigned _font_clock = 0;
 
 
 //enables or disables anti-aliased fonts
 static int _font_aa = 0;
 
 
+//returns the hash bucket of a font
+static _FONT_ENTRY **_font_hash(const char *path, const char *data, int size)
+{
+    unsigned long h = (unsigned long)(path ? 0 : data) ^ (unsigned long)size;
+
+    if (path) for(; *path; path++) h = h * 31 + (unsigned char)*path;
+    return _font_bucket + ((h ^ (h >> 6)) & (_FONT_BUCKETS - 1));
+}
+
+
+//returns true if a face is the face of the given path or memory font
+static int _is_font_face(const _FONT_FACE *face, const char *path, const char *data, int data_len)
+{
+    if (path) return face->path && !ustrcmp(face->path, path);
+    return !face->path && face->data == data && face->data_len == data_len;
+}
+
+
+//returns the alfont of a font, set to the font's size
+static ALFONT_FONT *_alfont(const FONT *f)
+{
+    _FONT_ENTRY *entry = (_FONT_ENTRY *)f->data;
+
+    if (entry->face->size != entry->size) {
+        alfont_set_font_size(entry->face->alfont, entry->size);
+        entry->face->size = entry->size;
+    }
+    return entry->face->alfont;
+}
+
+
+//size of a glyph atlas page
+#define _GLYPH_PAGE_SIZE     256
+
+
+//number of glyph hash buckets; must be a power of 2
+#define _GLYPH_BUCKETS       1024
+
+
+//glyph atlas page; glyphs are packed in shelves
+typedef struct _GLYPH_PAGE {
+    BITMAP *bmp;
+    int x;
+    int y;
+    int shelf_height;
+    unsigned used;
+} _GLYPH_PAGE;
+
+
+/* cached glyph of a font; the glyph coverage is in the atlas page 'page',
+   or nowhere if the glyph is empty (page is -1) or too big for a page
+   (page is -2) in which case it is rendered by alfont.
+ */
+typedef struct _GLYPH {
+    const FONT *font;
+    int ch;
+    int aa;
+    int advance;
+    int bearing_x;
+    int bearing_y;
+    int page;
+    int x;
+    int y;
+    int w;
+    int h;
+    struct _GLYPH *next;
+} _GLYPH;
+
+
+//glyph cache
+static _GLYPH *_glyph_bucket[_GLYPH_BUCKETS];
+static _GLYPH_PAGE *_glyph_page = NULL;
+static int _glyph_page_count = 0;
+static int _glyph_cache_size = 1 << 20;
+static unsigned _glyph_clock = 0;
+
+
+//bitmap glyphs are rasterized and composited into
+static BITMAP *_glyph_scratch = NULL;
+
+
+//tint table of the last foreground color
+static uint32_t _tint[256];
+static int _tint_color = -1;
+static int _tint_depth = 0;
+
+
+//returns the hash bucket of a glyph
+static _GLYPH **_glyph_hash(const FONT *f, int ch, int aa)
+{
+    unsigned long h = (unsigned long)f ^ ((unsigned long)ch * 31) ^ aa;
+    return _glyph_bucket + ((h ^ (h >> 10)) & (_GLYPH_BUCKETS - 1));
+}
+
+
+//returns a scratch bitmap of at least the given size, cleared to 0
+static BITMAP *_get_glyph_scratch(int w, int h)
+{
+    if (!_glyph_scratch || _glyph_scratch->w < w || _glyph_scratch->h < h) {
+        if (_glyph_scratch) {
+            w = MAX(w, _glyph_scratch->w);
+            h = MAX(h, _glyph_scratch->h);
+            destroy_bitmap(_glyph_scratch);
+        }
+        _glyph_scratch = create_bitmap_ex(32, w, h);
+        if (!_glyph_scratch) return NULL;
+    }
+    clear_to_color(_glyph_scratch, 0);
+    return _glyph_scratch;
+}
+
+
+//removes the glyphs of the given font and/or page from the cache
+static void _remove_glyphs(const FONT *f, int page)
+{
+    _GLYPH **prev, *glyph;
+    int i;
+
+    for(i = 0; i < _GLYPH_BUCKETS; i++) {
+        for(prev = _glyph_bucket + i; (glyph = *prev); ) {
+            if ((f && glyph->font != f) || (page >= 0 && glyph->page != page)) {
+                prev = &glyph->next;
+                continue;
+            }
+            *prev = glyph->next;
+            if (glyph->page >= 0) ((_FONT_ENTRY *)glyph->font->data)->memory -= glyph->w * glyph->h;
+            free(glyph);
+        }
+    }
+}
+
+
+//evicts the least recently used atlas page; pages used by the text being rendered
+//are kept unless 'all' is set; returns the page or -1 if there is none to evict
+static int _evict_glyph_page(int all)
+{
+    int i, lru = -1;
+
+    for(i = 0; i < _glyph_page_count; i++) {
+        if (!all && _glyph_page[i].used == _glyph_clock) continue;
+        if (lru < 0 || _glyph_clock - _glyph_page[i].used > _glyph_clock - _glyph_page[lru].used) lru = i;
+    }
+    if (lru < 0) return -1;
+    _remove_glyphs(NULL, lru);
+    clear_to_color(_glyph_page[lru].bmp, 0);
+    _glyph_page[lru].x = 0;
+    _glyph_page[lru].y = 0;
+    _glyph_page[lru].shelf_height = 0;
+    return lru;
+}
+
+
+//destroys atlas pages until the cache fits in its size
+static void _trim_glyph_pages(void)
+{
+    int page;
+
+    while (_glyph_page_count && _glyph_page_count * _GLYPH_PAGE_SIZE * _GLYPH_PAGE_SIZE > _glyph_cache_size) {
+        page = _evict_glyph_page(1);
+        destroy_bitmap(_glyph_page[page].bmp);
+
+        //the last page takes the place of the destroyed one
+        _glyph_page_count--;
+        if (page == _glyph_page_count) continue;
+        _remove_glyphs(NULL, _glyph_page_count);
+        _glyph_page[page] = _glyph_page[_glyph_page_count];
+        clear_to_color(_glyph_page[page].bmp, 0);
+        _glyph_page[page].x = 0;
+        _glyph_page[page].y = 0;
+        _glyph_page[page].shelf_height = 0;
+    }
+}
+
+
+//reserves atlas space for a glyph; returns the page or -1 on failure
+static int _alloc_glyph_space(int w, int h, int *x, int *y)
+{
+    _GLYPH_PAGE *page;
+    int i;
+
+    //try to fit the glyph in the current shelf of a page or in a new shelf
+    for(i = 0; i < _glyph_page_count; i++) {
+        page = _glyph_page + i;
+        if (page->x + w > _GLYPH_PAGE_SIZE) {
+            page->x = 0;
+            page->y += page->shelf_height;
+            page->shelf_height = 0;
+        }
+        if (page->y + h > _GLYPH_PAGE_SIZE) continue;
+        break;
+    }
+
+    //add a page or, if the cache is full, reuse the least recently used one
+    if (i == _glyph_page_count) {
+        if ((_glyph_page_count + 1) * _GLYPH_PAGE_SIZE * _GLYPH_PAGE_SIZE > _glyph_cache_size) {
+            i = _evict_glyph_page(0);
+            if (i < 0) return -1;
+        }
+        else {
+            page = (_GLYPH_PAGE *)realloc(_glyph_page, (_glyph_page_count + 1) * sizeof(_GLYPH_PAGE));
+            if (!page) return -1;
+            _glyph_page = page;
+            page += _glyph_page_count;
+            page->bmp = create_bitmap_ex(8, _GLYPH_PAGE_SIZE, _GLYPH_PAGE_SIZE);
+            if (!page->bmp) return -1;
+            clear_to_color(page->bmp, 0);
+            page->x = 0;
+            page->y = 0;
+            page->shelf_height = 0;
+            i = _glyph_page_count++;
+        }
+    }
+
+    page = _glyph_page + i;
+    *x = page->x;
+    *y = page->y;
+    page->x += w;
+    page->shelf_height = MAX(page->shelf_height, h);
+    page->used = _glyph_clock;
+    return i;
+}
+
+
+//rasterizes a glyph into the atlas
+static int _rasterize_glyph(_GLYPH *glyph)
+{
+    ALFONT_FONT *alfont = _alfont(glyph->font);
+    BITMAP *bmp;
+    char s[16];
+    int height = alfont_text_height(alfont);
+    int pad = height / 2 + 1;
+    int w = glyph->advance + pad * 2;
+    int x, y, l, t, r, b, a;
+
+    //render the glyph white on black; the green channel is the coverage
+    if (!(bmp = _get_glyph_scratch(w, height))) return 0;
+    usetc(s + usetc(s, glyph->ch), 0);
+    alfont_text_mode(-1);
+    if (glyph->aa)
+        alfont_textout_aa(bmp, alfont, s, pad, 0, makecol32(255, 255, 255));
+    else
+        alfont_textout(bmp, alfont, s, pad, 0, makecol32(255, 255, 255));
+
+    //find the glyph bounds
+    l = w;
+    t = height;
+    r = -1;
+    b = -1;
+    for(y = 0; y < height; y++) {
+        for(x = 0; x < w; x++) {
+            if (!getg32(((uint32_t *)bmp->line[y])[x])) continue;
+            if (x < l) l = x;
+            if (x > r) r = x;
+            if (y < t) t = y;
+            b = y;
+        }
+    }
+    glyph->page = -1;
+    if (r < 0) return 1;
+    glyph->bearing_x = l - pad;
+    glyph->bearing_y = t;
+    glyph->w = r - l + 1;
+    glyph->h = b - t + 1;
+
+    //glyphs bigger than a page are not cached
+    glyph->page = -2;
+    if (glyph->w > _GLYPH_PAGE_SIZE || glyph->h > _GLYPH_PAGE_SIZE) return 1;
+    glyph->page = _alloc_glyph_space(glyph->w, glyph->h, &glyph->x, &glyph->y);
+    if (glyph->page < 0) return 0;
+    ((_FONT_ENTRY *)glyph->font->data)->memory += glyph->w * glyph->h;
+
+    //copy the coverage
+    for(y = 0; y < glyph->h; y++) {
+        for(x = 0; x < glyph->w; x++) {
+            a = getg32(((uint32_t *)bmp->line[t + y])[l + x]);
+            _glyph_page[glyph->page].bmp->line[glyph->y + y][glyph->x + x] = glyph->aa ? a : (a ? 255 : 0);
+        }
+    }
+    return 1;
+}
+
+
+//returns the cached glyph of a character, rasterizing it if not in the cache
+static _GLYPH *_get_glyph(const FONT *f, int ch)
+{
+    _GLYPH **bucket = _glyph_hash(f, ch, _font_aa);
+    _GLYPH *glyph;
+    char s[16];
+
+    for(glyph = *bucket; glyph; glyph = glyph->next) {
+        if (glyph->font == f && glyph->ch == ch && glyph->aa == _font_aa) {
+            if (glyph->page >= 0) _glyph_page[glyph->page].used = _glyph_clock;
+            return glyph;
+        }
+    }
+
+    if (!(glyph = (_GLYPH *)malloc(sizeof(_GLYPH)))) return NULL;
+    glyph->font = f;
+    glyph->ch = ch;
+    glyph->aa = _font_aa;
+    usetc(s + usetc(s, ch), 0);
+    glyph->advance = alfont_text_length(_alfont(f), s);
+    if (!_rasterize_glyph(glyph)) {
+        free(glyph);
+        return NULL;
+    }
+    glyph->next = *bucket;
+    *bucket = glyph;
+    return glyph;
+}
+
+
+//sets up the tint table of a color
+static void _set_tint(int color, int depth)
+{
+    int r, g, b, a;
+
+    if (color == _tint_color && depth == _tint_depth) return;
+    _tint_color = color;
+    _tint_depth = depth;
+    r = getr_depth(depth, color);
+    g = getg_depth(depth, color);
+    b = getb_depth(depth, color);
+    for(a = 0; a < 256; a++) _tint[a] = makeacol32(r, g, b, a);
+}
+
+
+/* renders text through the glyph cache: the glyphs are composited in the
+   scratch bitmap as the foreground color with the coverage as alpha, which
+   is then alpha-blended on the target in one go; returns the text length
+   or -1 if the text could not be rendered this way.
+ */
+static int _render_glyphs(const FONT *f, const char *text, int fg, int bg, BITMAP *bmp, int x, int y)
+{
+    _GLYPH *glyph;
+    BITMAP *scratch;
+    const char *p;
+    unsigned char *src;
+    uint32_t *dst, pixel;
+    int ch, pen, l, r, gx, gy, i, j, big = 0;
+    int height = f->height;
+
+    if (bitmap_color_depth(bmp) == 8) return -1;
+    _glyph_clock++;
+
+    //measure the text and its overhangs
+    pen = 0;
+    l = 0;
+    r = 0;
+    for(p = text; (ch = ugetxc(&p)); ) {
+        if (!(glyph = _get_glyph(f, ch))) return -1;
+        if (glyph->page >= 0) {
+            l = MIN(l, pen + glyph->bearing_x);
+            r = MAX(r, pen + glyph->bearing_x + glyph->w);
+            height = MAX(height, glyph->bearing_y + glyph->h);
+        }
+        else if (glyph->page == -2) big = 1;
+        pen += glyph->advance;
+    }
+    r = MAX(r, pen);
+    if (bg >= 0 && pen > 0) rectfill(bmp, x, y, x + pen - 1, y + f->height - 1, bg);
+    if (r <= l) return pen;
+
+    //composite the glyphs
+    if (!(scratch = _get_glyph_scratch(r - l, height))) return -1;
+    _set_tint(fg, bitmap_color_depth(bmp));
+    pen = -l;
+    for(p = text; (ch = ugetxc(&p)); ) {
+        glyph = _get_glyph(f, ch);
+        if (glyph->page >= 0) {
+            gx = pen + glyph->bearing_x;
+            gy = glyph->bearing_y;
+            for(j = 0; j < glyph->h; j++) {
+                src = _glyph_page[glyph->page].bmp->line[glyph->y + j] + glyph->x;
+                dst = (uint32_t *)scratch->line[gy + j] + gx;
+                for(i = 0; i < glyph->w; i++) {
+                    if (!src[i]) continue;
+                    pixel = _tint[src[i]];
+                    if (!dst[i] || geta32(dst[i]) < src[i]) dst[i] = pixel;
+                }
+            }
+        }
+        pen += glyph->advance;
+    }
+    set_alpha_blender();
+    if (scratch->w == r - l && scratch->h == height)
+        draw_trans_sprite(bmp, scratch, x + l, y);
+    else if ((scratch = create_sub_bitmap(scratch, 0, 0, r - l, height))) {
+        draw_trans_sprite(bmp, scratch, x + l, y);
+        destroy_bitmap(scratch);
+    }
+
+    //glyphs too big for the atlas are rendered by alfont
+    if (big) {
+        char s[16];
+        alfont_text_mode(-1);
+        pen = 0;
+        for(p = text; (ch = ugetxc(&p)); ) {
+            glyph = _get_glyph(f, ch);
+            if (glyph->page == -2) {
+                usetc(s + usetc(s, ch), 0);
+                if (_font_aa)
+                    alfont_textout_aa(bmp, _alfont(f), s, x + pen, y, fg);
+                else
+                    alfont_textout(bmp, _alfont(f), s, x + pen, y, fg);
+            }
+            pen += glyph->advance;
+        }
+    }
+    return pen;
+}
+
+
 //returns the font height
 static int _font_height(const FONT *font)
 { 
-    return alfont_text_height(font->data); 
+    return alfont_text_height(_alfont(font)); 
 }
 
 
 //returns the character length
 static int _char_length(const FONT *f, int ch)
 {
+    _GLYPH *glyph = _get_glyph(f, ch);
     char s[16];
+
+    if (glyph) return glyph->advance;
     usetc(s, ch);
     usetat(s, -1, '\0');
-    return alfont_text_length(f->data, s);    
+    return alfont_text_length(_alfont(f), s);    
 }
 
 
 //returns the length of the text
 static int _text_length(const FONT *f, const char *text)
 {
-    return alfont_text_length(f->data, text);
+    _GLYPH *glyph;
+    const char *p;
+    int ch, len = 0;
+
+    for(p = text; (ch = ugetxc(&p)); ) {
+        if (!(glyph = _get_glyph(f, ch))) return alfont_text_length(_alfont(f), text);
+        len += glyph->advance;
+    }
+    return len;
 }
 
 
@@ -59,30 +518,56 @@ static int _text_length(const FONT *f, const char *text)
 static int _render_char(const FONT *f, int ch, int fg, int bg, BITMAP *bmp, int x, int y)
 {
     char s[16];
-    usetc(s, ch);
-    usetat(s, 1, '\0');
+    int len;
+
+    usetc(s + usetc(s, ch), '\0');
+    if ((len = _render_glyphs(f, s, fg, bg, bmp, x, y)) >= 0) return len;
     alfont_text_mode(bg);
     if(_font_aa)
-        alfont_textout_aa(bmp, f->data, s, x, y, fg);
+        alfont_textout_aa(bmp, _alfont(f), s, x, y, fg);
     else
-        alfont_textout(bmp, f->data, s, x, y, fg);
-    return alfont_text_length(f->data, s);
+        alfont_textout(bmp, _alfont(f), s, x, y, fg);
+    return alfont_text_length(_alfont(f), s);
 }
 
 
 //renders a line of text
 static void _render(const FONT *f, const char *text, int fg, int bg, BITMAP *bmp, int x, int y) {
+    if (_render_glyphs(f, text, fg, bg, bmp, x, y) >= 0) return;
     alfont_text_mode(bg);
     if(_font_aa)
-        alfont_textout_aa(bmp, f->data, text, x, y, fg);
+        alfont_textout_aa(bmp, _alfont(f), text, x, y, fg);
     else
-        alfont_textout(bmp, f->data, text, x, y, fg);
+        alfont_textout(bmp, _alfont(f), text, x, y, fg);
 }
 
 
-//destroys font
+//destroys font; the face is destroyed with its last size
 static void _destroy(FONT *f) {
-    alfont_destroy_font(f->data);
+    _FONT_ENTRY *entry = (_FONT_ENTRY *)f->data;
+    _FONT_FACE *face = entry->face, **face_prev;
+    _FONT_ENTRY **prev;
+
+    //a font allocated later at the same address must not get the cached lengths
+    awe_flush_text_metrics(f);
+    _remove_glyphs(f, -1);
+    for(prev = _font_hash(face->path, face->data, entry->size); *prev; prev = &(*prev)->next) {
+        if (*prev == entry) {
+            *prev = entry->next;
+            break;
+        }
+    }
+    free(entry);
+    free(f);
+
+    if (--face->entry_count) return;
+    for(face_prev = &first_face; *face_prev != face; face_prev = &(*face_prev)->next)
+        ;
+    *face_prev = face->next;
+    alfont_destroy_font(face->alfont);
+    if (face->path) free((char *)face->data);
+    free(face->path);
+    free(face);
 }
 
 
@@ -96,6 +581,142 @@ static FONT_VTABLE _alfont_vtable = {
     _destroy
 };
 
+
+//returns the memory used by a font
+static int _font_memory(const _FONT_ENTRY *entry)
+{
+    return sizeof(FONT) + sizeof(_FONT_ENTRY) + entry->memory;
+}
+
+
+//returns the memory used by all fonts
+static int _total_font_memory(void)
+{
+    _FONT_ENTRY *entry;
+    _FONT_FACE *face;
+    int i, memory = 0;
+
+    for(face = first_face; face; face = face->next) memory += face->memory;
+    for(i = 0; i < _FONT_BUCKETS; i++) {
+        for(entry = _font_bucket[i]; entry; entry = entry->next) memory += _font_memory(entry);
+    }
+    return memory;
+}
+
+
+//destroys the least recently unloaded fonts until the font memory fits in the budget
+static void _trim_fonts(void)
+{
+    _FONT_ENTRY *entry, *lru;
+    int i;
+
+    while (_total_font_memory() > _font_budget) {
+        lru = NULL;
+        for(i = 0; i < _FONT_BUCKETS; i++) {
+            for(entry = _font_bucket[i]; entry; entry = entry->next) {
+                if (entry->counter) continue;
+                if (!lru || _font_clock - entry->used > _font_clock - lru->used) lru = entry;
+            }
+        }
+        if (!lru) return;
+        TRACE("Font: Evicting Unused Font\n");
+        destroy_font(lru->font);
+    }
+}
+
+
+/* returns the font of a face and size, loading it if not loaded; the face is
+   either a file (path) or a memory font (data, data_len). if both are given,
+   the data is the file read into memory, and it is taken over.
+ */
+static FONT *_load_font(const char *path, const char *data, int data_len, int size)
+{
+    _FONT_ENTRY **bucket = _font_hash(path, data, size);
+    _FONT_ENTRY *entry;
+    _FONT_FACE *face;
+    FONT *new_font;
+
+    /* first, check to see if font is already loaded */
+    for(entry = *bucket; entry; entry = entry->next) {
+        if (entry->size == size && _is_font_face(entry->face, path, data, data_len)) {
+            TRACE("Font: %s Already Loaded\n", path ? path : "Memory Font");
+            if (path) free((char *)data);
+            /* add a reference if font is already loaded */
+            entry->counter++;
+            return entry->font;
+        }
+    }
+
+    /* find the face; other sizes of the font share it */
+    for(face = first_face; face; face = face->next) {
+        if (_is_font_face(face, path, data, data_len)) break;
+    }
+    if (face && path && data) {
+        /* the face is already loaded from the file */
+        free((char *)data);
+    }
+    if (!face) {
+        if((face = (_FONT_FACE *)malloc(sizeof(_FONT_FACE))) == NULL){
+            if (path) free((char *)data);
+            TRACE("Font: Failed to Allocate New Face\n");
+            return NULL;
+        }
+
+        /* try to load the alfont font */
+        face->alfont = data ? alfont_load_font_from_mem(data, data_len) : alfont_load_font(path);
+
+        /* if it does not exist, return the default font */
+        if (!face->alfont) {
+            if (path) free((char *)data);
+            free(face);
+            TRACE("Font: %s Failed to Load - Returning Default Font\n", path ? path : "Memory Font");
+            return font;
+        }
+        face->path = path ? ustrdup(path) : NULL;
+        face->data = data;
+        face->data_len = data_len;
+        face->size = 0;
+        face->memory = sizeof(_FONT_FACE) + (data ? data_len : (int)file_size_ex(path));
+        face->entry_count = 0;
+        face->next = first_face;
+        first_face = face;
+    }
+
+    /* setup the allegro font and its entry */
+    new_font = (FONT *)malloc(sizeof(FONT));
+    entry = (_FONT_ENTRY *)malloc(sizeof(_FONT_ENTRY));
+    if (!new_font || !entry) {
+        free(new_font);
+        free(entry);
+        if (!face->entry_count) {
+            first_face = face->next;
+            alfont_destroy_font(face->alfont);
+            if (face->path) free((char *)face->data);
+            free(face->path);
+            free(face);
+        }
+        TRACE("Font: Failed to Allocate New Font\n");
+        return NULL;
+    }
+    entry->face = face;
+    entry->font = new_font;
+    entry->size = size;
+    entry->counter = 1;
+    entry->memory = 0;
+    entry->used = 0;
+    entry->next = *bucket;
+    *bucket = entry;
+    face->entry_count++;
+
+    new_font->vtable = &_alfont_vtable;
+    new_font->data = entry;
+    new_font->height = alfont_text_height(_alfont(new_font));
+
+    _trim_fonts();
+    TRACE("Font: %s Loaded Successfully\n", path ? path : "Memory Font");
+    return new_font;
+}
+
 #endif
 
 
@@ -132,6 +753,35 @@ int awe_get_font_alias(void)
 }
 
 
+//sets the maximum size of the glyph cache, in bytes
+void awe_set_font_cache_size(int size)
+{
+
+    #ifdef TTFONT
+
+    _glyph_cache_size = MAX(size, 0);
+    _trim_glyph_pages();
+
+    #endif
+}
+
+
+//returns the maximum size of the glyph cache
+int awe_get_font_cache_size(void)
+{
+
+    #ifdef TTFONT
+
+    return _glyph_cache_size;
+
+    #else
+
+    return 0;
+
+    #endif
+}
+
+
 //initializes the font system if font_count is 0, increments font_count.
 int awe_install_font(void)
 {
@@ -153,61 +803,13 @@ int awe_install_font(void)
 }
 
 
-//adds a font to the list.
+//loads a font; fonts are shared by path and size
 FONT *awe_load_font(const char *path, int size)
 {
 
     #ifdef TTFONT
 
-    ALFONT_FONT *alfont;
-    _FONT_ENTRY *entry;
-    FONT *new_font;
-
-    /* first, check to see if font is already loaded */
-    for(entry = first_entry; entry; entry = entry->next) {
-        if (entry->size == size && !ustrcmp(path, entry->path)) {
-            TRACE("Font: %s Already Loaded\n", path);
-            /* add a reference if font is already loaded */
-            entry->counter++;
-            return entry->font;
-        }    
-    }
-    
-    /* try to load the alfont font */
-    alfont = alfont_load_font(path);
-
-    /* if it does not exist, return the default font */
-    if (!alfont) {
-        TRACE("Font: %s Failed to Load - Returning Default Font\n", path);
-        return font;
-    }
-    /* set size */
-    alfont_set_font_size(alfont, size);
-    
-    /* setup the allegro font */
-    if((new_font = (FONT *)malloc(sizeof(FONT))) == NULL){
-        TRACE("Font: %s Failed to Allocate New Font\n", path);
-        return NULL;
-    }
-    
-    new_font->height = alfont_text_height(alfont);
-    new_font->vtable = &_alfont_vtable;
-    new_font->data = alfont;
-    
-    /* add a new font entry */
-    if((entry = (_FONT_ENTRY *)malloc(sizeof(_FONT_ENTRY))) == NULL){
-        free(new_font);
-        TRACE("Font: %s Failed to Allocate New Entry\n", path);
-        return NULL;
-    }
-    entry->path = ustrdup(path);
-    entry->size = alfont_text_height(alfont);
-    entry->font = new_font;
-    entry->counter = 1;
-    entry->next = first_entry;
-    first_entry = entry;
-    TRACE("Font: %s Loaded Successfully\n", path);
-    return new_font;
+    return _load_font(path, NULL, 0, size);
 
     #else
 
@@ -218,41 +820,34 @@ FONT *awe_load_font(const char *path, int size)
 }
 
 
-//adds a font to the list.
+//loads a font from memory; fonts are shared by data and size
 FONT *awe_load_memory_font(const char *data, int data_len, int size)
 {
 
     #ifdef TTFONT
 
-    ALFONT_FONT *alfont;
-    FONT *new_font;
-    
-    /* try to load the alfont font */
-    alfont = alfont_load_font_from_mem(data, data_len);
+    return _load_font(NULL, data, data_len, size);
 
-    /* if it does not exist, return the default font */
-    if (!alfont) {
-        TRACE("Font: Failed to Load - Returning Default Font\n");
-        return font;
-    }
-    /* set size */
-    alfont_set_font_size(alfont, size);
-    
-    /* setup the allegro font */
-    if((new_font = (FONT *)malloc(sizeof(FONT))) == NULL){
-        TRACE("Font: Failed to Allocate New Font\n");
-        return NULL;
-    }
-    
-    new_font->height = alfont_text_height(alfont);
-    new_font->vtable = &_alfont_vtable;
-    new_font->data = alfont;
+    #else
+
+    return font;
+
+    #endif
     
-    TRACE("Font: Loaded Successfully\n");
-    return new_font;
+}
+
+
+//loads a font file that has been read into memory; the data is taken over
+FONT *awe_load_font_data(const char *path, char *data, int data_len, int size)
+{
+
+    #ifdef TTFONT
+
+    return _load_font(path, data, data_len, size);
 
     #else
 
+    free(data);
     return font;
 
     #endif
@@ -265,33 +860,25 @@ int awe_unload_font(FONT *font)
 {
     #ifdef TTFONT
 
-    _FONT_ENTRY *entry, *prev;
-    
-    /* find the font entry; font can be used as key since it is unique */
-    prev = NULL;
-    for(entry = first_entry; entry; entry = entry->next) {
-        if (entry->font == font)
-            break;
-        prev = entry;
-    }
+    _FONT_ENTRY *entry;
     
-    /* check if font is found */
-    if (entry == NULL) {
+    /* check if font is found; all loaded fonts use the alfont vtable */
+    if (!font || font->vtable != &_alfont_vtable) {
         TRACE("Font: Font Does Not Exist\n");
         return 0;
     }
+    entry = (_FONT_ENTRY *)font->data;
     
     /* del ref */
     entry->counter--;
     
-    /* remove entry and unload font if not needed */
+    /* unused fonts are kept within the budget; memory fonts are not kept,
+       since their data may go away */
     if (entry->counter == 0) {
-        if (prev) prev->next = entry->next; else first_entry = entry->next;
-        free(entry->path);
-        free(entry);
-        destroy_font(font);
+        entry->used = ++_font_clock;
+        if (!entry->face->path) destroy_font(font); else _trim_fonts();
     }
-    TRACE("Font: Font Destroyed Successfully\n");
+    TRACE("Font: Font Unloaded Successfully\n");
 
     #endif
 
@@ -299,6 +886,56 @@ int awe_unload_font(FONT *font)
 }
 
 
+//sets the memory that may be used by unused fonts
+void awe_set_font_budget(int size)
+{
+
+    #ifdef TTFONT
+
+    _font_budget = MAX(size, 0);
+    _trim_fonts();
+
+    #endif
+}
+
+
+//returns the font budget
+int awe_get_font_budget(void)
+{
+
+    #ifdef TTFONT
+
+    return _font_budget;
+
+    #else
+
+    return 0;
+
+    #endif
+}
+
+
+//returns the memory used by a font, or by all fonts if the font is null
+int awe_get_font_memory(FONT *font)
+{
+
+    #ifdef TTFONT
+
+    _FONT_ENTRY *entry;
+
+    if (!font) return _total_font_memory();
+    if (font->vtable != &_alfont_vtable) return 0;
+    entry = (_FONT_ENTRY *)font->data;
+    return _font_memory(entry) + entry->face->memory;
+
+    #else
+
+    return 0;
+
+    #endif
+}
+
+
 //cleans up and shuts down the font system if font_count is 1, decrements font_count.
 void awe_font_exit(void)
 {
@@ -306,15 +943,18 @@ void awe_font_exit(void)
 
         #ifdef TTFONT
         
-        _FONT_ENTRY *entry, *next;
-        for(entry = first_entry; entry; ) {
-            next = entry->next;
-            free(entry->path);
-            destroy_font(entry->font);
-            free(entry);
-            entry = next;
-            TRACE("Font: Font Destroyed Successfully\n");
+        int i;
+        for(i = 0; i < _FONT_BUCKETS; i++) {
+            while (_font_bucket[i]) {
+                destroy_font(_font_bucket[i]->font);
+                TRACE("Font: Font Destroyed Successfully\n");
+            }
         }
+        while (_glyph_page_count) destroy_bitmap(_glyph_page[--_glyph_page_count].bmp);
+        free(_glyph_page);
+        _glyph_page = NULL;
+        if (_glyph_scratch) destroy_bitmap(_glyph_scratch);
+        _glyph_scratch = NULL;
         alfont_exit();
         TRACE("Font: Shutdown Successful\n");
 
@@ -323,4 +963,3 @@ void awe_font_exit(void)
     }
     _font_install_count--;
 }
-
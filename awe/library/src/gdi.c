@@ -24,6 +24,733 @@ enum _SIDE {
 }
 
 
+//size of the buffer used for drawing runs of text
+#define _RUN_SIZE            256
+
+
+//draws a run of characters with one call to the font; returns its width
+static int _draw_run(BITMAP *bmp, const FONT *font, const char *text, int size, int x, int y, int fg_color, int bg_color)
+{
+    char buf[_RUN_SIZE], *run = buf;
+    int w;
+
+    if (size <= 0) return 0;
+
+    //the run must be null-terminated
+    if (size + ucwidth(0) > _RUN_SIZE) {
+        run = (char *)malloc(size + ucwidth(0));
+        if (!run) return 0;
+    }
+    memcpy(run, text, size);
+    usetc(run + size, 0);
+
+    w = font->vtable->text_length(font, run);
+    font->vtable->render(font, run, fg_color, bg_color, bmp, x, y);
+
+    if (run != buf) free(run);
+    return w;
+}
+
+
+//returns true for text formats where characters below 128 are single bytes
+#define _IS_BYTE_FORMAT(FMT)      ((FMT) == U_ASCII || (FMT) == U_UTF8)
+
+
+//decodes a character and advances the text; single byte characters are decoded inline
+#define _UGETXC(FMT, TEXT)\
+    ((FMT) == U_ASCII || ((FMT) == U_UTF8 && !(*(TEXT) & 0x80)) ? *(const unsigned char *)(TEXT)++ : ugetxc(&(TEXT)))
+
+
+//word with all bytes set to 1 and with all bytes set to 128
+#define _ONES                ((unsigned long)-1 / 255)
+#define _HIGHS               (_ONES * 128)
+
+
+//returns true if a word has a zero byte or a byte with the high bit set
+#define _HAS_ZERO_OR_HIGH(W) ((((W) - _ONES) & ~(W) & _HIGHS) | ((W) & _HIGHS))
+
+
+/* returns the first byte of the text before 'end' that is non-ASCII or, if
+   'amp' is set, '&', or 'end' if there is none; whole words before 'end'
+   are scanned a word at a time.
+ */
+static const char *_scan_ascii(const char *text, const char *end, int amp)
+{
+    unsigned long v;
+
+    for(; end - text >= (int)sizeof(unsigned long); text += sizeof(unsigned long)) {
+        memcpy(&v, text, sizeof(unsigned long));
+        if (v & _HIGHS) break;
+        if (amp && _HAS_ZERO_OR_HIGH(v ^ (_ONES * '&'))) break;
+    }
+    for(; text < end && !(*text & 0x80) && !(amp && *text == '&'); text++)
+        ;
+    return text;
+}
+
+
+/* advances the text by up to 'len' characters or to the terminator,
+   decrementing 'len' by the number of characters skipped; runs of ASCII
+   are skipped without decoding them.
+ */
+static const char *_skip_chars(const char *text, int *len)
+{
+    int fmt = get_uformat(), n;
+    const char *end, *stop = _IS_BYTE_FORMAT(fmt) ? text + strlen(text) : text;
+
+    while (*len > 0) {
+        if (_IS_BYTE_FORMAT(fmt)) {
+            end = _scan_ascii(text, stop, 0);
+            n = MIN(end - text, *len);
+            text += n;
+            *len -= n;
+            if (!*len) break;
+        }
+        if (!ugetc(text)) break;
+        _UGETXC(fmt, text);
+        (*len)--;
+    }
+    return text;
+}
+
+
+//number of text metrics cache entries; must be a power of 2
+#define _TEXT_METRICS_SIZE   64
+
+
+//text metrics cache entry; the text is kept to validate the string identity
+typedef struct _TEXT_METRICS {
+    const FONT *font;
+    const char *key;
+    char *text;
+    int gui;
+    int length;
+} _TEXT_METRICS;
+
+
+//text metrics cache
+static _TEXT_METRICS _text_metrics[_TEXT_METRICS_SIZE];
+
+
+//returns the width of gui text, as drawn by awe_draw_gui_text
+static int _gui_text_length(const FONT *font, const char *text)
+{
+    int fmt = get_uformat(), ac = 0, ch, w = 0;
+
+    while ((ch = _UGETXC(fmt, text))) {
+        if (ch == '&') {
+            ac++;
+            continue;
+        }
+        for(; ac > 1; ac--) w += font->vtable->char_length(font, '&');
+        ac = 0;
+        w += font->vtable->char_length(font, ch);
+    }
+    return w;
+}
+
+
+//returns the cached length of a text
+static int _get_text_metrics(const FONT *font, const char *text, int gui)
+{
+    unsigned long h = (unsigned long)font ^ ((unsigned long)text >> 2) ^ gui;
+    _TEXT_METRICS *tm = _text_metrics + ((h ^ (h >> 8)) & (_TEXT_METRICS_SIZE - 1));
+
+    if (tm->font == font && tm->key == text && tm->gui == gui && !ustrcmp(tm->text, text)) return tm->length;
+
+    free(tm->text);
+    tm->font = font;
+    tm->key = text;
+    tm->gui = gui;
+    tm->length = gui ? _gui_text_length(font, text) : font->vtable->text_length(font, text);
+    tm->text = (char *)malloc(ustrsizez(text));
+    if (tm->text)
+        memcpy(tm->text, text, ustrsizez(text));
+    else
+        tm->font = NULL;
+    return tm->length;
+}
+
+
+//maximum number of pixels of a cached gradient
+#define _GRADIENT_CACHE_PIXELS   65536
+
+
+//number of cached gradients
+#define _GRADIENT_CACHE_SIZE     16
+
+
+//gradient color; channels are 16.16 fixed point; for 8-bit, 'r' is the palette index
+typedef struct _GRADIENT_COLOR {
+    int r;
+    int g;
+    int b;
+} _GRADIENT_COLOR;
+
+
+//cached gradient
+typedef struct _GRADIENT {
+    BITMAP *bmp;
+    int depth;
+    int color[4];
+    unsigned used;
+} _GRADIENT;
+
+
+//gradient row kernel; fills 'w' pixels starting from color 'c', adding 'd' per pixel
+typedef void (*_GRADIENT_KERNEL)(unsigned char *line, int w, _GRADIENT_COLOR c, const _GRADIENT_COLOR *d);
+
+
+//gradient cache
+static _GRADIENT _gradient_cache[_GRADIENT_CACHE_SIZE];
+static unsigned _gradient_clock = 0;
+
+
+//bitmap gradients too big for the cache are rendered in
+static BITMAP *_gradient_row = NULL;
+
+
+//8-bit gradient kernel
+static void _gradient_kernel_8(unsigned char *line, int w, _GRADIENT_COLOR c, const _GRADIENT_COLOR *d)
+{
+    for(; w > 0; w--, c.r += d->r) {
+        *line++ = c.r >> 16;
+    }
+}
+
+
+//15-bit gradient kernel
+static void _gradient_kernel_15(unsigned char *line, int w, _GRADIENT_COLOR c, const _GRADIENT_COLOR *d)
+{
+    uint16_t *p = (uint16_t *)line;
+
+    for(; w > 0; w--, c.r += d->r, c.g += d->g, c.b += d->b) {
+        *p++ = ((c.r >> 19) << _rgb_r_shift_15) | ((c.g >> 19) << _rgb_g_shift_15) | ((c.b >> 19) << _rgb_b_shift_15);
+    }
+}
+
+
+//16-bit gradient kernel
+static void _gradient_kernel_16(unsigned char *line, int w, _GRADIENT_COLOR c, const _GRADIENT_COLOR *d)
+{
+    uint16_t *p = (uint16_t *)line;
+
+    for(; w > 0; w--, c.r += d->r, c.g += d->g, c.b += d->b) {
+        *p++ = ((c.r >> 19) << _rgb_r_shift_16) | ((c.g >> 18) << _rgb_g_shift_16) | ((c.b >> 19) << _rgb_b_shift_16);
+    }
+}
+
+
+//24-bit gradient kernel
+static void _gradient_kernel_24(unsigned char *line, int w, _GRADIENT_COLOR c, const _GRADIENT_COLOR *d)
+{
+    uint32_t pixel;
+
+    for(; w > 0; w--, c.r += d->r, c.g += d->g, c.b += d->b) {
+        pixel = ((c.r >> 16) << _rgb_r_shift_24) | ((c.g >> 16) << _rgb_g_shift_24) | ((c.b >> 16) << _rgb_b_shift_24);
+        #ifdef ALLEGRO_BIG_ENDIAN
+        *line++ = pixel >> 16;
+        *line++ = pixel >> 8;
+        *line++ = pixel;
+        #else
+        *line++ = pixel;
+        *line++ = pixel >> 8;
+        *line++ = pixel >> 16;
+        #endif
+    }
+}
+
+
+//32-bit gradient kernel
+static void _gradient_kernel_32(unsigned char *line, int w, _GRADIENT_COLOR c, const _GRADIENT_COLOR *d)
+{
+    uint32_t *p = (uint32_t *)line;
+
+    for(; w > 0; w--, c.r += d->r, c.g += d->g, c.b += d->b) {
+        *p++ = ((c.r >> 16) << _rgb_r_shift_32) | ((c.g >> 16) << _rgb_g_shift_32) | ((c.b >> 16) << _rgb_b_shift_32);
+    }
+}
+
+
+//returns the gradient kernel of a color depth
+static _GRADIENT_KERNEL _get_gradient_kernel(int depth)
+{
+    switch (depth) {
+        case 8 : return _gradient_kernel_8;
+        case 15: return _gradient_kernel_15;
+        case 16: return _gradient_kernel_16;
+        case 24: return _gradient_kernel_24;
+        case 32: return _gradient_kernel_32;
+    }
+    return NULL;
+}
+
+
+//splits a color to gradient channels
+static void _get_gradient_color(int depth, int color, _GRADIENT_COLOR *c)
+{
+    if (depth == 8) {
+        c->r = color << 16;
+        c->g = 0;
+        c->b = 0;
+        return;
+    }
+    c->r = getr_depth(depth, color) << 16;
+    c->g = getg_depth(depth, color) << 16;
+    c->b = getb_depth(depth, color) << 16;
+}
+
+
+//interpolates two gradient colors; 't' is the distance from c1 of 'len'
+static void _lerp_gradient_color(const _GRADIENT_COLOR *c1, const _GRADIENT_COLOR *c2, int t, int len, _GRADIENT_COLOR *c)
+{
+    c->r = c1->r + (int)((double)(c2->r - c1->r) * t / len);
+    c->g = c1->g + (int)((double)(c2->g - c1->g) * t / len);
+    c->b = c1->b + (int)((double)(c2->b - c1->b) * t / len);
+}
+
+
+/* renders row 'y' of a w x h bilinear gradient into a memory bitmap, at
+   row 'row'; colors are top-left, bottom-left, bottom-right, top-right. As
+   with quad3d, the colors are at the corners of the pixel grid, so the
+   last row and column are one step before the far colors.
+ */
+static void _render_gradient_row(BITMAP *bmp, int row, int y, int w, int h, int color1, int color2, int color3, int color4)
+{
+    int depth = bitmap_color_depth(bmp);
+    _GRADIENT_KERNEL kernel = _get_gradient_kernel(depth);
+    _GRADIENT_COLOR tl, bl, br, tr, left, right, d;
+
+    _get_gradient_color(depth, color1, &tl);
+    _get_gradient_color(depth, color2, &bl);
+    _get_gradient_color(depth, color3, &br);
+    _get_gradient_color(depth, color4, &tr);
+    _lerp_gradient_color(&tl, &bl, y, h, &left);
+    _lerp_gradient_color(&tr, &br, y, h, &right);
+    d.r = (right.r - left.r) / w;
+    d.g = (right.g - left.g) / w;
+    d.b = (right.b - left.b) / w;
+
+    //round to nearest
+    left.r += 0x8000;
+    left.g += 0x8000;
+    left.b += 0x8000;
+    kernel(bmp->line[row], w, left, &d);
+}
+
+
+//returns a bitmap of a single gradient row
+static BITMAP *_get_gradient_row(int depth, int w)
+{
+    if (!_get_gradient_kernel(depth)) return NULL;
+    if (_gradient_row && (_gradient_row->w != w || bitmap_color_depth(_gradient_row) != depth)) {
+        destroy_bitmap(_gradient_row);
+        _gradient_row = NULL;
+    }
+    if (!_gradient_row) _gradient_row = create_bitmap_ex(depth, w, 1);
+    return _gradient_row;
+}
+
+
+//returns the cached bitmap of a gradient, rendering it if not in the cache; returns null if too big
+static BITMAP *_get_gradient(int depth, int w, int h, int color1, int color2, int color3, int color4)
+{
+    _GRADIENT *gradient, *lru = _gradient_cache;
+    int i;
+
+    if (w <= 0 || h <= 0 || w * h > _GRADIENT_CACHE_PIXELS || !_get_gradient_kernel(depth)) return NULL;
+    _gradient_clock++;
+
+    for(i = 0; i < _GRADIENT_CACHE_SIZE; i++) {
+        gradient = _gradient_cache + i;
+        if (gradient->bmp && gradient->depth == depth && gradient->bmp->w == w && gradient->bmp->h == h &&
+            gradient->color[0] == color1 && gradient->color[1] == color2 &&
+            gradient->color[2] == color3 && gradient->color[3] == color4) {
+            gradient->used = _gradient_clock;
+            return gradient->bmp;
+        }
+        if (!gradient->bmp || (lru->bmp && _gradient_clock - gradient->used > _gradient_clock - lru->used)) lru = gradient;
+    }
+
+    //replace the least recently used gradient
+    if (lru->bmp && (lru->depth != depth || lru->bmp->w != w || lru->bmp->h != h)) {
+        destroy_bitmap(lru->bmp);
+        lru->bmp = NULL;
+    }
+    if (!lru->bmp && !(lru->bmp = create_bitmap_ex(depth, w, h))) return NULL;
+    lru->depth = depth;
+    lru->color[0] = color1;
+    lru->color[1] = color2;
+    lru->color[2] = color3;
+    lru->color[3] = color4;
+    lru->used = _gradient_clock;
+    for(i = 0; i < h; i++) _render_gradient_row(lru->bmp, i, i, w, h, color1, color2, color3, color4);
+    return lru->bmp;
+}
+
+
+//shadow kernel; darkens 'w' pixels by the given translucencies, advancing 'inc' per pixel
+typedef void (*_SHADOW_KERNEL)(unsigned char *line, int w, const int *trans, int inc);
+
+
+/* the shadow kernels blend black over the pixels exactly as the trans
+   blender does, so they give the same output as drawing black lines in
+   translucent mode
+ */
+
+
+//15-bit shadow kernel
+static void _shadow_kernel_15(unsigned char *line, int w, const int *trans, int inc)
+{
+    uint16_t *p = (uint16_t *)line;
+    unsigned long n, y, res;
+
+    for(; w > 0; w--, p++, trans += inc) {
+        n = *trans;
+        if (n) n = (n + 1) / 8;
+        y = *p;
+        y = ((y & 0xFFFF) | (y << 16)) & 0x3E07C1F;
+        res = ((0 - y) * n / 32 + y) & 0x3E07C1F;
+        *p = (res & 0xFFFF) | (res >> 16);
+    }
+}
+
+
+//16-bit shadow kernel
+static void _shadow_kernel_16(unsigned char *line, int w, const int *trans, int inc)
+{
+    uint16_t *p = (uint16_t *)line;
+    unsigned long n, y, res;
+
+    for(; w > 0; w--, p++, trans += inc) {
+        n = *trans;
+        if (n) n = (n + 1) / 8;
+        y = *p;
+        y = ((y & 0xFFFF) | (y << 16)) & 0x7E0F81F;
+        res = ((0 - y) * n / 32 + y) & 0x7E0F81F;
+        *p = (res & 0xFFFF) | (res >> 16);
+    }
+}
+
+
+//darkens a 24/32-bit pixel
+#define _SHADOW_PIXEL_24(Y, N, RES) {\
+    unsigned long g;\
+    RES = ((0 - ((Y) & 0xFF00FF)) * (N) / 256 + (Y)) & 0xFF00FF;\
+    g = ((0 - ((Y) & 0xFF00)) * (N) / 256 + ((Y) & 0xFF00)) & 0xFF00;\
+    RES |= g;\
+}
+
+
+//24-bit shadow kernel
+static void _shadow_kernel_24(unsigned char *line, int w, const int *trans, int inc)
+{
+    unsigned long n, y, res;
+
+    for(; w > 0; w--, line += 3, trans += inc) {
+        n = *trans;
+        if (n) n++;
+        #ifdef ALLEGRO_BIG_ENDIAN
+        y = ((unsigned long)line[0] << 16) | (line[1] << 8) | line[2];
+        #else
+        y = line[0] | (line[1] << 8) | ((unsigned long)line[2] << 16);
+        #endif
+        _SHADOW_PIXEL_24(y, n, res);
+        #ifdef ALLEGRO_BIG_ENDIAN
+        line[0] = res >> 16;
+        line[1] = res >> 8;
+        line[2] = res;
+        #else
+        line[0] = res;
+        line[1] = res >> 8;
+        line[2] = res >> 16;
+        #endif
+    }
+}
+
+
+//32-bit shadow kernel
+static void _shadow_kernel_32(unsigned char *line, int w, const int *trans, int inc)
+{
+    uint32_t *p = (uint32_t *)line;
+    unsigned long n, y, res;
+
+    for(; w > 0; w--, p++, trans += inc) {
+        n = *trans;
+        if (n) n++;
+        y = *p;
+        _SHADOW_PIXEL_24(y, n, res);
+        *p = res;
+    }
+}
+
+
+//returns the shadow kernel of a bitmap, or null if the bitmap can not be drawn directly
+static _SHADOW_KERNEL _get_shadow_kernel(BITMAP *bmp)
+{
+    if (!is_memory_bitmap(bmp)) return NULL;
+    switch (bitmap_color_depth(bmp)) {
+        case 15: return _shadow_kernel_15;
+        case 16: return _shadow_kernel_16;
+        case 24: return _shadow_kernel_24;
+        case 32: return _shadow_kernel_32;
+    }
+    return NULL;
+}
+
+
+//draws a clipped horizontal span of shadow; 'trans' is the translucency at x1
+static void _draw_shadow_span(BITMAP *bmp, int x1, int x2, int y, const int *trans, int inc)
+{
+    int bpp = BYTES_PER_PIXEL(bitmap_color_depth(bmp));
+
+    if (y < bmp->ct || y >= bmp->cb) return;
+    if (x1 < bmp->cl) {
+        trans += (bmp->cl - x1) * inc;
+        x1 = bmp->cl;
+    }
+    if (x2 >= bmp->cr) x2 = bmp->cr - 1;
+    if (x1 > x2) return;
+    _get_shadow_kernel(bmp)(bmp->line[y] + x1 * bpp, x2 - x1 + 1, trans, inc);
+}
+
+
+//reads a row of pixels like getpixel does; pixels outside of the bitmap are -1
+static void _get_pixel_row(BITMAP *bmp, int x, int y, int w, int *row)
+{
+    unsigned char *line;
+    int i, l, r;
+
+    if (y < 0 || y >= bmp->h || !is_memory_bitmap(bmp)) {
+        for(i = 0; i < w; i++) row[i] = getpixel(bmp, x + i, y);
+        return;
+    }
+
+    //pixels inside the bitmap are read from the line directly
+    l = MID(0, -x, w);
+    r = MID(l, bmp->w - x, w);
+    for(i = 0; i < l; i++) row[i] = -1;
+    for(i = r; i < w; i++) row[i] = -1;
+    line = bmp->line[y];
+    switch (bitmap_color_depth(bmp)) {
+        case 8:
+            for(i = l; i < r; i++) row[i] = line[x + i];
+            break;
+
+        case 15:
+        case 16:
+            for(i = l; i < r; i++) row[i] = ((uint16_t *)line)[x + i];
+            break;
+
+        case 24:
+            for(i = l; i < r; i++) {
+                unsigned char *p = line + (x + i) * 3;
+                #ifdef ALLEGRO_BIG_ENDIAN
+                row[i] = (p[0] << 16) | (p[1] << 8) | p[2];
+                #else
+                row[i] = p[0] | (p[1] << 8) | (p[2] << 16);
+                #endif
+            }
+            break;
+
+        case 32:
+            for(i = l; i < r; i++) row[i] = ((uint32_t *)line)[x + i];
+            break;
+    }
+}
+
+
+//writes a pixel to a memory bitmap
+#define _PUT_PIXEL(BMP, DEPTH, X, Y, COLOR) {\
+    unsigned char *_p = (BMP)->line[Y];\
+    switch (DEPTH) {\
+        case 8 : _p[X] = (COLOR); break;\
+        case 15:\
+        case 16: ((uint16_t *)_p)[X] = (COLOR); break;\
+        case 32: ((uint32_t *)_p)[X] = (COLOR); break;\
+        default:\
+            _p += (X) * 3;\
+            _PUT_PIXEL_24(_p, COLOR);\
+    }\
+}
+
+
+//writes a 24-bit pixel
+#ifdef ALLEGRO_BIG_ENDIAN
+    #define _PUT_PIXEL_24(P, COLOR) { (P)[0] = (COLOR) >> 16; (P)[1] = (COLOR) >> 8; (P)[2] = (COLOR); }
+#else
+    #define _PUT_PIXEL_24(P, COLOR) { (P)[0] = (COLOR); (P)[1] = (COLOR) >> 8; (P)[2] = (COLOR) >> 16; }
+#endif
+
+
+//returns the range of steps [*k1, *k2) from 'p' by 'd' that is inside [c1, c2)
+static void _clip_steps(int p, int d, int c1, int c2, int *k1, int *k2)
+{
+    if (d > 0) {
+        *k1 = MAX(*k1, c1 - p);
+        *k2 = MIN(*k2, c2 - p);
+    }
+    else if (d < 0) {
+        *k1 = MAX(*k1, p - c2 + 1);
+        *k2 = MIN(*k2, p - c1 + 1);
+    }
+    else if (p < c1 || p >= c2) {
+        *k2 = *k1;
+    }
+}
+
+
+/* draws the pixels of a line for which the mask is set; the line starts
+   at x, y and goes by dx, dy per pixel; the line is clipped once, then
+   memory bitmaps are written directly, unless a special drawing mode is set
+ */
+static void _put_mask_pixels(BITMAP *bmp, int x, int y, int dx, int dy, const unsigned char *mask, int n, int color)
+{
+    int depth = bitmap_color_depth(bmp);
+    int k, k1 = 0, k2 = n;
+
+    _clip_steps(x, dx, bmp->cl, bmp->cr, &k1, &k2);
+    _clip_steps(y, dy, bmp->ct, bmp->cb, &k1, &k2);
+    if (!is_memory_bitmap(bmp) || _drawing_mode != DRAW_MODE_SOLID) {
+        for(k = k1; k < k2; k++) {
+            if (mask[k]) putpixel(bmp, x + k * dx, y + k * dy, color);
+        }
+        return;
+    }
+    for(k = k1; k < k2; k++) {
+        if (mask[k]) _PUT_PIXEL(bmp, depth, x + k * dx, y + k * dy, color);
+    }
+}
+
+
+//number of texture cache hash buckets; must be a power of 2
+#define _TEXTURE_BUCKETS     64
+
+
+//texture rendered at a specific size
+typedef struct _TEXTURE_ENTRY {
+    const AWE_TEXTURE *tex;
+    int type;
+    BITMAP *bmp;
+    unsigned used;
+    struct _TEXTURE_ENTRY *next;
+} _TEXTURE_ENTRY;
+
+
+//texture cache
+static _TEXTURE_ENTRY *_texture_bucket[_TEXTURE_BUCKETS];
+static int _texture_cache_size = 1 << 20;
+static int _texture_cache_memory = 0;
+static unsigned _texture_clock = 0;
+
+
+//set while a texture is rendered into the cache
+static int _rendering_texture = 0;
+
+
+//returns the memory of a texture cache entry
+static int _texture_entry_memory(const _TEXTURE_ENTRY *entry)
+{
+    return entry->bmp->w * entry->bmp->h * BYTES_PER_PIXEL(bitmap_color_depth(entry->bmp));
+}
+
+
+//returns the texture cache bucket of a texture
+static _TEXTURE_ENTRY **_texture_hash(const AWE_TEXTURE *tex, int w, int h)
+{
+    unsigned long k = ((unsigned long)tex >> 4) ^ (w * 31) ^ (h * 17);
+    return _texture_bucket + ((k ^ (k >> 6)) & (_TEXTURE_BUCKETS - 1));
+}
+
+
+//removes the cached renderings of a texture, or the least recently used one if tex is null
+static void _remove_texture_entries(const AWE_TEXTURE *tex)
+{
+    _TEXTURE_ENTRY **prev, *entry, **lru = NULL;
+    int i;
+
+    for(i = 0; i < _TEXTURE_BUCKETS; i++) {
+        for(prev = _texture_bucket + i; (entry = *prev); ) {
+            if (!tex) {
+                if (!lru || _texture_clock - entry->used > _texture_clock - (*lru)->used) lru = prev;
+            }
+            else if (entry->tex == tex) {
+                *prev = entry->next;
+                _texture_cache_memory -= _texture_entry_memory(entry);
+                destroy_bitmap(entry->bmp);
+                free(entry);
+                continue;
+            }
+            prev = &entry->next;
+        }
+    }
+    if (lru) {
+        entry = *lru;
+        *lru = entry->next;
+        _texture_cache_memory -= _texture_entry_memory(entry);
+        destroy_bitmap(entry->bmp);
+        free(entry);
+    }
+}
+
+
+//draws a texture from the cache, rendering it if not in the cache; returns 0 if the texture is not cached
+static int _draw_cached_texture(const AWE_CANVAS *canvas, const AWE_TEXTURE *tex, int x1, int y1, int x2, int y2, int type)
+{
+    int depth = bitmap_color_depth(canvas->bitmap);
+    int w, h, memory;
+    _TEXTURE_ENTRY **bucket, *entry;
+    AWE_CANVAS cache_canvas;
+    AWE_RECT area;
+
+    if (_rendering_texture) return 0;
+    if (x1 > x2) _SWAP(int, x1, x2);
+    if (y1 > y2) _SWAP(int, y1, y2);
+    w = x2 - x1 + 1;
+    h = y2 - y1 + 1;
+
+    //big textures are not worth keeping
+    memory = w * h * BYTES_PER_PIXEL(depth);
+    if (memory > _texture_cache_size / 4) return 0;
+    _texture_clock++;
+
+    bucket = _texture_hash(tex, w, h);
+    for(entry = *bucket; entry; entry = entry->next) {
+        if (entry->tex == tex && entry->type == type && entry->bmp->w == w && entry->bmp->h == h &&
+            bitmap_color_depth(entry->bmp) == depth) break;
+    }
+
+    //render the texture on the mask color, so as that it is drawn masked as before
+    if (!entry) {
+        while (_texture_cache_memory + memory > _texture_cache_size) _remove_texture_entries(NULL);
+        if (!(entry = (_TEXTURE_ENTRY *)malloc(sizeof(_TEXTURE_ENTRY)))) return 0;
+        if (!(entry->bmp = create_bitmap_ex(depth, w, h))) {
+            free(entry);
+            return 0;
+        }
+        entry->tex = tex;
+        entry->type = type;
+        entry->next = *bucket;
+        *bucket = entry;
+        _texture_cache_memory += memory;
+
+        clear_to_color(entry->bmp, bitmap_mask_color(entry->bmp));
+        area.left = 0;
+        area.top = 0;
+        area.right = w - 1;
+        area.bottom = h - 1;
+        awe_set_canvas(&cache_canvas, entry->bmp, &area);
+        _rendering_texture = 1;
+        awe_draw_texture_type(&cache_canvas, tex, 0, 0, w - 1, h - 1, type >> 1, type & 1);
+        _rendering_texture = 0;
+    }
+
+    entry->used = _texture_clock;
+    masked_blit(entry->bmp, canvas->bitmap, 0, 0, x1 + AWE_CANVAS_BASE_X(canvas), y1 + AWE_CANVAS_BASE_Y(canvas), w, h);
+    return 1;
+}
+
+
 //draws a fat pixel
 static void _fat_putpixel(BITMAP *bmp, int x, int y, int c)
 {
@@ -82,11 +809,44 @@ static INLINE void _stretch(BITMAP *dst, BITMAP *src, int x, int y, int w, int h
 }
 
 
+//color conversion; the depth is the one colors were last made for
+static unsigned _color_version = 1;
+static int _colors_made_depth = 0;
+
+
 /*****************************************************************************
     PUBLIC
  *****************************************************************************/
 
 
+//returns the length of a text
+int awe_get_text_length(const FONT *font, const char *text)
+{
+    return _get_text_metrics(font, text, 0);
+}
+
+
+//returns the length of gui text
+int awe_get_gui_text_length(const FONT *font, const char *text)
+{
+    return _get_text_metrics(font, text, 1);
+}
+
+
+//flushes the text metrics of a font, or of all fonts if the font is null
+void awe_flush_text_metrics(const FONT *font)
+{
+    int i;
+
+    for(i = 0; i < _TEXT_METRICS_SIZE; i++) {
+        if (font && _text_metrics[i].font != font) continue;
+        free(_text_metrics[i].text);
+        _text_metrics[i].text = NULL;
+        _text_metrics[i].font = NULL;
+    }
+}
+
+
 //prepares a canvas for drawing
 void awe_set_canvas(AWE_CANVAS *canvas, BITMAP *bmp, AWE_RECT *area)
 {
@@ -247,15 +1007,39 @@ void awe_fill_ellipse(const AWE_CANVAS *canvas, int x, int y, int hor_radius, in
 //fills a gradient
 void awe_fill_gradient(const AWE_CANVAS *canvas, int x1, int y1, int x2, int y2, int color1, int color2, int color3, int color4)
 {
-    x1 = itofix(x1 + AWE_CANVAS_BASE_X(canvas));
-    y1 = itofix(y1 + AWE_CANVAS_BASE_Y(canvas));
-    x2 = itofix(x2 + AWE_CANVAS_BASE_X(canvas) + 1);
-    y2 = itofix(y2 + AWE_CANVAS_BASE_Y(canvas) + 1); {
-    V3D v1 = {x1, y1, 0, 0, 0, color1};
-    V3D v2 = {x1, y2, 0, 0, 0, color2};
-    V3D v3 = {x2, y2, 0, 0, 0, color3};
-    V3D v4 = {x2, y1, 0, 0, 0, color4};
-    quad3d(canvas->bitmap, POLYTYPE_GCOL, 0, &v1, &v2, &v3, &v4);
+    BITMAP *bmp;
+    int y;
+
+    //the colors stay on the corners of their vertices
+    if (x2 < x1) {
+        _SWAP(int, x1, x2);
+        _SWAP(int, color1, color4);
+        _SWAP(int, color2, color3);
+    }
+    if (y2 < y1) {
+        _SWAP(int, y1, y2);
+        _SWAP(int, color1, color2);
+        _SWAP(int, color3, color4);
+    }
+    x1 += AWE_CANVAS_BASE_X(canvas);
+    y1 += AWE_CANVAS_BASE_Y(canvas);
+    x2 += AWE_CANVAS_BASE_X(canvas);
+    y2 += AWE_CANVAS_BASE_Y(canvas);
+
+    //repeated gradients are blitted from the cache
+    bmp = _get_gradient(bitmap_color_depth(canvas->bitmap), x2 - x1 + 1, y2 - y1 + 1, color1, color2, color3, color4);
+    if (bmp) {
+        blit(bmp, canvas->bitmap, 0, 0, x1, y1, bmp->w, bmp->h);
+        return;
+    }
+
+    //gradients too big for the cache are rendered a row at a time
+    bmp = _get_gradient_row(bitmap_color_depth(canvas->bitmap), x2 - x1 + 1);
+    if (!bmp) return;
+    for(y = y1; y <= y2; y++) {
+        if (y < canvas->bitmap->ct || y >= canvas->bitmap->cb) continue;
+        _render_gradient_row(bmp, 0, y - y1, x2 - x1 + 1, y2 - y1 + 1, color1, color2, color3, color4);
+        blit(bmp, canvas->bitmap, 0, 0, x1, y, bmp->w, 1);
     }
 }
 
@@ -473,7 +1257,8 @@ void awe_draw_3d_frame_s(const AWE_CANVAS *canvas, int x, int y, int w, int h, i
 //draws a rectangular pattern
 void awe_draw_rect_pattern(const AWE_CANVAS *canvas, int x1, int y1, int x2, int y2, int color, unsigned pt)
 {
-    int i;
+    unsigned char *mask;
+    int i, n;
 
     //offset coords
     x1 += AWE_CANVAS_BASE_X(canvas);
@@ -485,29 +1270,20 @@ void awe_draw_rect_pattern(const AWE_CANVAS *canvas, int x1, int y1, int x2, int
     if (x1 > x2) _SWAP(int, x1, x2);
     if (y1 > y2) _SWAP(int, y1, y2);
 
-    //top line
-    for(i = x1; i < x2; i++) {
-        if (pt & 1) putpixel(canvas->bitmap, i, y1, color);
-        pt = (pt >> 1) | (pt << 31);
-    }
-
-    //right line
-    for(i = y1; i < y2; i++) {
-        if (pt & 1) putpixel(canvas->bitmap, x2, i, color);
-        pt = (pt >> 1) | (pt << 31);
-    }
-
-    //bottom line
-    for(i = x2; i > x1; i--) {
-        if (pt & 1) putpixel(canvas->bitmap, i, y2, color);
+    //the pattern bits of the lines, in drawing order
+    n = 2 * (x2 - x1) + 2 * (y2 - y1);
+    if (!n || !(mask = (unsigned char *)malloc(n))) return;
+    for(i = 0; i < n; i++) {
+        mask[i] = pt & 1;
         pt = (pt >> 1) | (pt << 31);
     }
 
-    //left line
-    for(i = y2; i > y1; i--) {
-        if (pt & 1) putpixel(canvas->bitmap, x1, i, color);
-        pt = (pt >> 1) | (pt << 31);
-    }
+    //top, right, bottom and left lines
+    _put_mask_pixels(canvas->bitmap, x1, y1, 1, 0, mask, x2 - x1, color);
+    _put_mask_pixels(canvas->bitmap, x2, y1, 0, 1, mask + x2 - x1, y2 - y1, color);
+    _put_mask_pixels(canvas->bitmap, x2, y2, -1, 0, mask + (x2 - x1) + (y2 - y1), x2 - x1, color);
+    _put_mask_pixels(canvas->bitmap, x1, y2, 0, -1, mask + 2 * (x2 - x1) + (y2 - y1), y2 - y1, color);
+    free(mask);
 }
 
 
@@ -521,14 +1297,12 @@ void awe_draw_rect_pattern_s(const AWE_CANVAS *canvas, int x, int y, int w, int
 //draws text of specific length
 int awe_draw_text_len(const AWE_CANVAS *canvas, const FONT *font, const char *text, int len, int x, int y, int fg_color, int bg_color, const char **text_r)
 {
+    const char *run = text;
+
     x += AWE_CANVAS_BASE_X(canvas);
     y += AWE_CANVAS_BASE_Y(canvas);
-    for(; len > 0; len--) {
-        int ch = ugetc(text);
-        if (!ch) break;
-        x += font->vtable->render_char(font, ch, fg_color, bg_color, canvas->bitmap, x, y);
-        text += ucwidth(ch);
-    }
+    text = _skip_chars(text, &len);
+    x += _draw_run(canvas->bitmap, font, run, text - run, x, y, fg_color, bg_color);
     if (text_r) *text_r = text;
     return x - AWE_CANVAS_BASE_X(canvas);
 }
@@ -537,20 +1311,27 @@ int awe_draw_text_len(const AWE_CANVAS *canvas, const FONT *font, const char *te
 //draws text until coordinate is reached
 int awe_draw_text_pix(const AWE_CANVAS *canvas, const FONT *font, const char *text, int x2, int x, int y, int fg_color, int bg_color, const char **text_r)
 {
-    int next_x;
+    const char *run = text, *next;
+    int fmt = get_uformat(), ch, run_x, next_x;
+
+    //no need to measure each character if the whole text fits
+    if (x + awe_get_text_length(font, text) <= x2)
+        return awe_draw_text_len(canvas, font, text, INT_MAX, x, y, fg_color, bg_color, text_r);
 
     x += AWE_CANVAS_BASE_X(canvas);
     y += AWE_CANVAS_BASE_Y(canvas);
     x2 += AWE_CANVAS_BASE_X(canvas);
+    run_x = x;
     for(;;) {
-        int ch = ugetc(text);
+        next = text;
+        ch = _UGETXC(fmt, next);
         if (!ch) break;
         next_x = x + font->vtable->char_length(font, ch);
         if (next_x > x2) break;
-        font->vtable->render_char(font, ch, fg_color, bg_color, canvas->bitmap, x, y);
         x = next_x;
-        text += ucwidth(ch);
+        text = next;
     }
+    _draw_run(canvas->bitmap, font, run, text - run, run_x, y, fg_color, bg_color);
     if (text_r) *text_r = text;
     return x - AWE_CANVAS_BASE_X(canvas);
 }
@@ -566,58 +1347,62 @@ int awe_draw_text(const AWE_CANVAS *canvas, const FONT *font, const char *text,
 //draws gui text up to specific length
 int awe_draw_gui_text_len(const AWE_CANVAS *canvas, const FONT *font, const char *text, int len, int x, int y, int fg_color, int bg_color, const char **text_r)
 {
-    int ac = 0, ch, xx;
+    int fmt = get_uformat(), ac = 0, ch, xx;
+    const char *run = text, *next, *stop = _IS_BYTE_FORMAT(fmt) ? text + strlen(text) : text;
 
     //offset coords
     x += AWE_CANVAS_BASE_X(canvas);
     y += AWE_CANVAS_BASE_Y(canvas);
 
-    //draw first part until first single '&'
-    for(;;) {
+    //characters between '&' are drawn as runs
+    while (len > 0) {
+        //skip plain ASCII characters at once
+        if (!ac && _IS_BYTE_FORMAT(fmt)) {
+            xx = MIN(_scan_ascii(text, stop, 1) - text, len);
+            text += xx;
+            len -= xx;
+            if (len <= 0) break;
+        }
+
         //get character
-        ch = ugetc(text);
+        next = text;
+        ch = _UGETXC(fmt, next);
 
         //end of text found
         if (!ch) break;
 
-        //draw characters
-        if (ch != '&') {
-            //single '&' found; draw next character underlined
-            if (ac == 1) {
-                xx = x + font->vtable->char_length(font, ch);
-                hline(canvas->bitmap, x, y + text_height(font) + gui_font_baseline, xx - 1, fg_color);
-                ac = 0;
-            }
-
-            //more than 1 '&' found; draw them
-            else if (ac > 1) {
-                for(; ac > 1; ac--) {
-                    x += font->vtable->render_char(font, '&', fg_color, bg_color, canvas->bitmap, x, y);
-                    len--;
-                    if (len <= 0) break;
-                }
-                if (len <= 0) break;
-                ac = 0;
-            }
+        //count '&'; draw the run before it
+        if (ch == '&') {
+            x += _draw_run(canvas->bitmap, font, run, text - run, x, y, fg_color, bg_color);
+            ac++;
+            text = next;
+            run = text;
+            continue;
+        }
 
-            //draw char
-            x += font->vtable->render_char(font, ch, fg_color, bg_color, canvas->bitmap, x, y);
-            len--;
-            if (len <= 0) {
-                text += ucwidth(ch);
-                break;
-            }
+        //single '&' found; underline this character
+        if (ac == 1) {
+            xx = x + font->vtable->char_length(font, ch);
+            hline(canvas->bitmap, x, y + text_height(font) + gui_font_baseline, xx - 1, fg_color);
         }
 
-        //else count '&'
+        //more than 1 '&' found; draw them
         else {
-            ac++;
+            for(; ac > 1 && len > 0; ac--, len--) {
+                x += font->vtable->render_char(font, '&', fg_color, bg_color, canvas->bitmap, x, y);
+            }
+            if (len <= 0) break;
         }
+        ac = 0;
 
         //next text
-        text += ucwidth(ch);
+        text = next;
+        len--;
     }
 
+    //draw the last run
+    x += _draw_run(canvas->bitmap, font, run, text - run, x, y, fg_color, bg_color);
+
     if (text_r) *text_r = text;
     return x - AWE_CANVAS_BASE_X(canvas);
 }
@@ -626,60 +1411,72 @@ int awe_draw_gui_text_len(const AWE_CANVAS *canvas, const FONT *font, const char
 //draws gui text until coordinate is reached
 int awe_draw_gui_text_pix(const AWE_CANVAS *canvas, const FONT *font, const char *text, int x2, int x, int y, int fg_color, int bg_color, const char **text_r)
 {
-    int ac = 0, ch, xx;
+    const char *run = text, *next;
+    int fmt = get_uformat(), ac = 0, ch, xx, run_x;
+
+    //no need to measure each character if the whole text fits
+    if (x + awe_get_gui_text_length(font, text) <= x2)
+        return awe_draw_gui_text_len(canvas, font, text, INT_MAX, x, y, fg_color, bg_color, text_r);
 
     //offset coords
     x += AWE_CANVAS_BASE_X(canvas);
     y += AWE_CANVAS_BASE_Y(canvas);
     x2 += AWE_CANVAS_BASE_X(canvas);
+    run_x = x;
 
-    //draw first part until first single '&'
+    //characters between '&' are measured, then drawn as runs
     for(;;) {
         //get character
-        ch = ugetc(text);
+        next = text;
+        ch = _UGETXC(fmt, next);
 
         //end of text found
         if (!ch) break;
 
-        //draw characters
-        if (ch != '&') {
-            //single '&' found; draw next character underlined
-            if (ac == 1) {
-                xx = x + font->vtable->char_length(font, ch);
-                if (xx > x2) {
-                    text -= ucwidth(ch);
-                    break;
-                }
-                hline(canvas->bitmap, x, y + text_height(font) + gui_font_baseline, xx - 1, fg_color);
-                ac = 0;
+        //count '&'; draw the run before it
+        if (ch == '&') {
+            _draw_run(canvas->bitmap, font, run, text - run, run_x, y, fg_color, bg_color);
+            ac++;
+            text = next;
+            run = text;
+            run_x = x;
+            continue;
+        }
+
+        //single '&' found; underline this character
+        if (ac == 1) {
+            xx = x + font->vtable->char_length(font, ch);
+            if (xx > x2) {
+                text -= ucwidth('&');
+                break;
             }
+            hline(canvas->bitmap, x, y + text_height(font) + gui_font_baseline, xx - 1, fg_color);
+        }
 
-            //more than 1 '&' found; draw them
-            else if (ac > 1) {
-                for(; ac > 1; ac--) {
-                    xx = x + font->vtable->char_length(font, '&');
-                    if (xx > x2) break;
-                    x += font->vtable->render_char(font, '&', fg_color, bg_color, canvas->bitmap, x, y);
-                }
+        //more than 1 '&' found; draw them
+        else if (ac > 1) {
+            for(; ac > 1; ac--) {
+                xx = x + font->vtable->char_length(font, '&');
                 if (xx > x2) break;
-                ac = 0;
+                x += font->vtable->render_char(font, '&', fg_color, bg_color, canvas->bitmap, x, y);
             }
-
-            //draw char
-            xx = x + font->vtable->char_length(font, '&');
-            if (xx > x2) break;
-            x += font->vtable->render_char(font, ch, fg_color, bg_color, canvas->bitmap, x, y);
+            run_x = x;
+            if (ac > 1) break;
         }
+        ac = 0;
 
-        //else count '&'
-        else {
-            ac++;
-        }
+        //measure char
+        xx = x + font->vtable->char_length(font, ch);
+        if (xx > x2) break;
+        x = xx;
 
         //next text
-        text += ucwidth(ch);
+        text = next;
     }
 
+    //draw the last run
+    _draw_run(canvas->bitmap, font, run, text - run, run_x, y, fg_color, bg_color);
+
     if (text_r) *text_r = text;
     return x - AWE_CANVAS_BASE_X(canvas);
 }
@@ -723,36 +1520,54 @@ void awe_blit_masked_stretch_bitmap(BITMAP *src, const AWE_CANVAS *canvas, int s
 //monochrome bit-blit
 void awe_blit_mono_bitmap(BITMAP *src, const AWE_CANVAS *canvas, int src_x, int src_y, int dst_x, int dst_y, int width, int height, int color)
 {
-    int i, j, p, m = bitmap_mask_color(src);
+    int i, j, *row, m = bitmap_mask_color(src);
+    unsigned char *mask;
 
+    if (width <= 0 || height <= 0) return;
     dst_x += AWE_CANVAS_BASE_X(canvas);
     dst_y += AWE_CANVAS_BASE_Y(canvas);
-    for(j = src_y; j < src_y + height; j++) {
-        for(i = src_x; i < src_x + width; i++) {
-            p = getpixel(src, i, j);
-            if (p != m) putpixel(canvas->bitmap, i + dst_x, j + dst_y, color);
+    row = (int *)malloc(width * sizeof(int));
+    mask = (unsigned char *)malloc(width);
+    if (row && mask) {
+        for(j = src_y; j < src_y + height; j++) {
+            _get_pixel_row(src, src_x, j, width, row);
+            for(i = 0; i < width; i++) mask[i] = row[i] != m;
+            _put_mask_pixels(canvas->bitmap, src_x + dst_x, j + dst_y, 1, 0, mask, width, color);
         }
     }
+    free(row);
+    free(mask);
 }
 
 
 //3d bit-blit
 void awe_blit_3d_bitmap(BITMAP *src, const AWE_CANVAS *canvas, int src_x, int src_y, int dst_x, int dst_y, int width, int height, int top_left_color, int bottom_right_color)
 {
-    int i, j, p, m = bitmap_mask_color(src);
+    int i, j, *row, *prev, m = bitmap_mask_color(src);
+    unsigned char *mask, *edge;
 
+    if (width <= 0 || height <= 0) return;
     dst_x += AWE_CANVAS_BASE_X(canvas);
     dst_y += AWE_CANVAS_BASE_Y(canvas);
-    for(j = src_y; j < src_y + height; j++) {
-        for(i = src_x; i < src_x + width; i++) {
-            p = getpixel(src, i, j);
-            if (p != m) putpixel(canvas->bitmap, i + dst_x, j + dst_y, top_left_color);
-            else {
-                p = getpixel(src, i - 1, j - 1);
-                if (p > 0 && p != m) putpixel(canvas->bitmap, i + dst_x, j + dst_y, bottom_right_color);
+    row = (int *)malloc(2 * width * sizeof(int));
+    mask = (unsigned char *)malloc(2 * width);
+    if (row && mask) {
+        prev = row + width;
+        edge = mask + width;
+        for(j = src_y; j < src_y + height; j++) {
+            //a masked pixel is an edge if the pixel up and left of it is not masked
+            _get_pixel_row(src, src_x, j, width, row);
+            _get_pixel_row(src, src_x - 1, j - 1, width, prev);
+            for(i = 0; i < width; i++) {
+                mask[i] = row[i] != m;
+                edge[i] = !mask[i] && prev[i] > 0 && prev[i] != m;
             }
+            _put_mask_pixels(canvas->bitmap, src_x + dst_x, j + dst_y, 1, 0, mask, width, top_left_color);
+            _put_mask_pixels(canvas->bitmap, src_x + dst_x, j + dst_y, 1, 0, edge, width, bottom_right_color);
         }
     }
+    free(row);
+    free(mask);
 }
 
 
@@ -968,16 +1783,75 @@ void awe_destroy_texture(AWE_TEXTURE *texture)
 {
     int i;
 
+    _remove_texture_entries(texture);
     for(i = 0; i < 9; i++) destroy_bitmap(texture->bitmap[i]);
     free(texture);
 }
 
 
+//sets the memory budget of the texture cache
+void awe_set_texture_cache_size(int size)
+{
+    _texture_cache_size = MAX(size, 0);
+    while (_texture_cache_memory > _texture_cache_size) _remove_texture_entries(NULL);
+}
+
+
+//returns the memory budget of the texture cache
+int awe_get_texture_cache_size(void)
+{
+    return _texture_cache_size;
+}
+
+
+//drops the cached renderings of a texture
+void awe_flush_texture_cache(const AWE_TEXTURE *texture)
+{
+    if (texture) _remove_texture_entries(texture);
+}
+
+
+//returns the version of the color conversion
+unsigned awe_get_color_version(void)
+{
+    return _color_version;
+}
+
+
+//checks the color depth the colors are made for
+int awe_check_color_depth(BITMAP *bmp)
+{
+    if (!bmp || bitmap_color_depth(bmp) == _colors_made_depth) return FALSE;
+    _colors_made_depth = bitmap_color_depth(bmp);
+    awe_invalidate_colors();
+    return TRUE;
+}
+
+
+//changes the color version
+void awe_invalidate_colors(void)
+{
+    //0 is kept for colors never made
+    if (!++_color_version) _color_version = 1;
+}
+
+
+//converts the color of a text shadow
+int awe_make_shadow_color(RGB s)
+{
+    int c = AWE_MAKE_COLOR(s);
+
+    return c == makecol(255, 0, 255) ? -1 : c;
+}
+
+
 //draws a texture
 void awe_draw_texture(const AWE_CANVAS *canvas, const AWE_TEXTURE *tex, int x1, int y1, int x2, int y2)
 {
     int w, h;
 
+    if (_draw_cached_texture(canvas, tex, x1, y1, x2, y2, 0)) return;
+
     if (x1 > x2) _SWAP(int, x1, x2);
     if (y1 > y2) _SWAP(int, y1, y2);
     x1 += AWE_CANVAS_BASE_X(canvas);
@@ -1018,6 +1892,7 @@ void awe_draw_texture_hor(const AWE_CANVAS *canvas, const AWE_TEXTURE *tex, int
     int w, h, x3;
 
     if (!tex->bitmap[4]) return;
+    if (_draw_cached_texture(canvas, tex, x1, y1, x2, y2, 1)) return;
     if (x1 > x2) _SWAP(int, x1, x2);
     if (y1 > y2) _SWAP(int, y1, y2);
     x1 += AWE_CANVAS_BASE_X(canvas);
@@ -1083,6 +1958,7 @@ void awe_draw_texture_ver(const AWE_CANVAS *canvas, const AWE_TEXTURE *tex, int
     AWE_RECT new_clip;
     int w, h, y3;
     if (!tex->bitmap[4]) return;
+    if (_draw_cached_texture(canvas, tex, x1, y1, x2, y2, 2)) return;
     if (x1 > x2) _SWAP(int, x1, x2);
     if (y1 > y2) _SWAP(int, y1, y2);
     x1 += AWE_CANVAS_BASE_X(canvas);
@@ -1148,6 +2024,7 @@ void awe_draw_texture_hor_ver(const AWE_CANVAS *canvas, const AWE_TEXTURE *tex,
     AWE_RECT new_clip;
     int w, h, y3;
     if (!tex->bitmap[4]) return;
+    if (_draw_cached_texture(canvas, tex, x1, y1, x2, y2, 3)) return;
     if (x1 > x2) _SWAP(int, x1, x2);
     if (y1 > y2) _SWAP(int, y1, y2);
     x1 += AWE_CANVAS_BASE_X(canvas);
@@ -1236,7 +2113,7 @@ void awe_draw_texture_type_s(const AWE_CANVAS *canvas, const AWE_TEXTURE *tex, i
 void awe_draw_shadow(const AWE_CANVAS *canvas, int x1, int y1, int x2, int y2, int start_trans, int end_trans, int hor)
 {
     double trans_delta, trans;
-    int i, black;
+    int *ramp, i, n, y, black;
 
     start_trans = MID(0, start_trans, 255);
     end_trans = MID(0, end_trans, 255);
@@ -1246,6 +2123,27 @@ void awe_draw_shadow(const AWE_CANVAS *canvas, int x1, int y1, int x2, int y2, i
     y1 += AWE_CANVAS_BASE_Y(canvas);
     x2 += AWE_CANVAS_BASE_X(canvas);
     y2 += AWE_CANVAS_BASE_Y(canvas);
+
+    //the ramp of translucencies; the shadow is blended in one pass over the rectangle
+    n = hor ? x2 - x1 + 1 : y2 - y1 + 1;
+    if (_get_shadow_kernel(canvas->bitmap) && (ramp = (int *)malloc(n * sizeof(int)))) {
+        trans_delta = ((double)(end_trans - start_trans + 1)) / (double)n;
+        trans = start_trans;
+        for(i = 0; i < n; i++) {
+            ramp[i] = (int)trans;
+            trans += trans_delta;
+            if (trans < 0) trans = 0; else if (trans > 255) trans = 255;
+        }
+        for(y = y1; y <= y2; y++) {
+            if (hor)
+                _draw_shadow_span(canvas->bitmap, x1, x2, y, ramp, 1);
+            else
+                _draw_shadow_span(canvas->bitmap, x1, x2, y, ramp + y - y1, 0);
+        }
+        free(ramp);
+        return;
+    }
+
     black = makecol_depth(bitmap_color_depth(canvas->bitmap), 0, 0, 0);
     drawing_mode(DRAW_MODE_TRANS, 0, 0, 0);
     acquire_bitmap(canvas->bitmap);
@@ -1286,7 +2184,7 @@ void awe_draw_shadow_s(const AWE_CANVAS *canvas, int x, int y, int w, int h, int
 void awe_draw_bottom_right_shadow(const AWE_CANVAS *canvas, int x1, int y1, int x2, int y2, int start_trans, int end_trans, int width)
 {
     double trans_delta, trans;
-    int black;
+    int *ramp, i, d, y, black;
 
     if (width <= 0) return;
     start_trans = MID(0, start_trans, 255);
@@ -1297,6 +2195,33 @@ void awe_draw_bottom_right_shadow(const AWE_CANVAS *canvas, int x1, int y1, int
     y1 += AWE_CANVAS_BASE_Y(canvas);
     x2 += AWE_CANVAS_BASE_X(canvas);
     y2 += AWE_CANVAS_BASE_Y(canvas);
+
+    /* the ramp goes from the outer edge inwards; a row at distance d from
+       the bottom is the edge's ramp, preceded by the d'th translucency if
+       the row is inside the shadow's width
+     */
+    if (_get_shadow_kernel(canvas->bitmap) && (ramp = (int *)malloc(width * sizeof(int)))) {
+        trans_delta = ((double)(end_trans - start_trans + 1)) / ((double)width);
+        trans = start_trans;
+        for(i = 0; i < width; i++) {
+            ramp[i] = (int)trans;
+            trans += trans_delta;
+            if (trans < 0) trans = 0; else if (trans > 255) trans = 255;
+        }
+        for(y = y1; y <= y2; y++) {
+            d = y2 - y;
+            if (d < width) {
+                _draw_shadow_span(canvas->bitmap, x1, x2 - d - 1, y, ramp + width - 1 - d, 0);
+                _draw_shadow_span(canvas->bitmap, x2 - d, x2, y, ramp + width - 1 - d, 1);
+            }
+            else {
+                _draw_shadow_span(canvas->bitmap, x2 - width + 1, x2, y, ramp, 1);
+            }
+        }
+        free(ramp);
+        return;
+    }
+
     black = makecol_depth(bitmap_color_depth(canvas->bitmap), 0, 0, 0);
     drawing_mode(DRAW_MODE_TRANS, 0, 0, 0);
     acquire_bitmap(canvas->bitmap);
@@ -19,6 +19,11 @@
 #define MAX_TIMER            8
 
 
+//event record file signature and version
+#define RECORD_MAGIC         DAT_ID('A', 'W', 'E', 'R')
+#define RECORD_VERSION       1
+
+
 //event queue type
 typedef struct QUEUE {
     int free;
@@ -43,16 +48,29 @@ static unsigned _timer = 0;
 static void (*prev_mouse_callback)(int) = 0;
 static int (*prev_keyboard_ucallback)(int, int*) = 0;
 static void (*prev_keyboard_lowlevel_callback)(int) = 0;
-static QUEUE event_queue = {0, 0, 0};
+static QUEUE queues[2];
+static QUEUE *event_queue = queues;
+static QUEUE *front_queue = queues;
+static int batching = FALSE;
 static int mouse_button = 0;
 static int key_table[KEY_MAX];
 static TIMER timer[MAX_TIMER];
+static PACKFILE *record_file = 0;
+static unsigned record_time = 0;
+static PACKFILE *replay_file = 0;
+static unsigned replay_clock = 0;
+static unsigned replay_time = 0;
+static int replay_pending = FALSE;
+static AWE_EVENT replay_event;
+static int replaying = FALSE;
 
 
 //externals
 extern void _install_event_lock();
 extern void _lock_events();
 extern void _unlock_events();
+extern int _start_input_thread(void (*proc)(), int msecs);
+extern void _stop_input_thread();
 
 
 //allocates an event entry in the given queue
@@ -85,13 +103,22 @@ static INLINE AWE_EVENT *free_event(QUEUE *q)
 END_OF_STATIC_FUNCTION(free_event);
 
 
+//returns the last event put in the given queue
+static INLINE AWE_EVENT *last_event(QUEUE *q)
+{
+    if (!q->used) return 0;
+    return q->event + (q->free ? q->free : MAX_EVENT) - 1;
+}
+END_OF_STATIC_FUNCTION(last_event);
+
+
 //puts a timer event
 static INLINE void put_timer_event(AWE_EVENT_TYPE type, int id, void *data)
 {
     AWE_EVENT *e;
 
     _lock_events();
-    e = alloc_event(&event_queue);
+    e = alloc_event(event_queue);
     if (e) {
         e->timer.type = type;
         e->timer.time = _timer;
@@ -108,8 +135,17 @@ static INLINE void put_mouse_event(AWE_EVENT_TYPE type)
 {
     AWE_EVENT *e;
 
+    if (replaying) return;
     _lock_events();
-    e = alloc_event(&event_queue);
+
+    //while batching, consecutive mouse moves are coalesced into one
+    e = 0;
+    if (batching && type == AWE_EVENT_MOUSE_MOVE) {
+        e = last_event(event_queue);
+        if (e && e->type != AWE_EVENT_MOUSE_MOVE) e = 0;
+    }
+    if (!e) e = alloc_event(event_queue);
+
     if (e) {
         e->mouse.type = type;
         e->mouse.time = _timer;
@@ -129,8 +165,9 @@ static INLINE void put_key_event(AWE_EVENT_TYPE type, int key, int scancode)
 {
     AWE_EVENT *e;
 
+    if (replaying) return;
     _lock_events();
-    e = alloc_event(&event_queue);
+    e = alloc_event(event_queue);
     if (e) {
         e->key.type = type;
         e->key.time = _timer;
@@ -260,6 +297,105 @@ static TIMER *_find_empty_timer()
 }
 
 
+//polls the input devices that need polling; called from the input thread
+static void _poll_input()
+{
+    if (mouse_needs_poll()) poll_mouse();
+    if (keyboard_needs_poll()) poll_keyboard();
+}
+
+
+//enumerates the events of a queue; returns zero if enumeration stopped
+static int _enum_queue(QUEUE *q, AWE_EVENT_ENUM_PROC proc, void *data)
+{
+    AWE_EVENT *event;
+    int i;
+
+    event = q->event + q->avail;
+    for(i = 0; i < q->used; ++i) {
+        if (!proc(event, data)) return 0;
+        ++event;
+        if (event == q->event + MAX_EVENT) event = q->event;
+    }
+    return 1;
+}
+
+
+//writes an event to the record file; only device events are recorded
+static void _record_event(const AWE_EVENT *event)
+{
+    switch (event->type) {
+        case AWE_EVENT_BUTTON_DOWN:
+        case AWE_EVENT_BUTTON_UP:
+        case AWE_EVENT_MOUSE_MOVE:
+        case AWE_EVENT_MOUSE_WHEEL:
+            pack_putc(event->type, record_file);
+            pack_iputl(event->mouse.time - record_time, record_file);
+            pack_iputw(event->mouse.shifts, record_file);
+            pack_iputw(event->mouse.x, record_file);
+            pack_iputw(event->mouse.y, record_file);
+            pack_iputw(event->mouse.z, record_file);
+            pack_putc(event->mouse.button, record_file);
+            break;
+
+        case AWE_EVENT_KEY_DOWN:
+        case AWE_EVENT_KEY_UP:
+            pack_putc(event->type, record_file);
+            pack_iputl(event->key.time - record_time, record_file);
+            pack_iputw(event->key.shifts, record_file);
+            pack_iputw(event->key.key, record_file);
+            pack_putc(event->key.scancode, record_file);
+            break;
+
+        default:
+            return;
+    }
+    record_time = event->mouse.time;
+}
+
+
+//reads the next event from the replay file; time is the delay from the previous one
+static int _read_replay_event(AWE_EVENT *event, unsigned *time)
+{
+    int type = pack_getc(replay_file);
+
+    switch (type) {
+        case AWE_EVENT_BUTTON_DOWN:
+        case AWE_EVENT_BUTTON_UP:
+        case AWE_EVENT_MOUSE_MOVE:
+        case AWE_EVENT_MOUSE_WHEEL:
+            event->mouse.type = type;
+            *time = pack_igetl(replay_file);
+            event->mouse.shifts = pack_igetw(replay_file);
+            event->mouse.x = pack_igetw(replay_file);
+            event->mouse.y = pack_igetw(replay_file);
+            event->mouse.z = pack_igetw(replay_file);
+            event->mouse.button = pack_getc(replay_file);
+            return event->mouse.button != EOF;
+
+        case AWE_EVENT_KEY_DOWN:
+        case AWE_EVENT_KEY_UP:
+            event->key.type = type;
+            *time = pack_igetl(replay_file);
+            event->key.shifts = pack_igetw(replay_file);
+            event->key.key = pack_igetw(replay_file);
+            event->key.scancode = pack_getc(replay_file);
+            return event->key.scancode != EOF;
+    }
+    return 0;
+}
+
+
+//reads the next pending replay event, if there is one
+static void _next_replay_event()
+{
+    unsigned delay;
+
+    replay_pending = _read_replay_event(&replay_event, &delay);
+    if (replay_pending) replay_time += delay;
+}
+
+
 /*****************************************************************************
     PUBLIC
  *****************************************************************************/
@@ -280,12 +416,16 @@ void awe_install_input()
     LOCK_VARIABLE(prev_mouse_callback);
     LOCK_VARIABLE(prev_keyboard_ucallback);
     LOCK_VARIABLE(prev_keyboard_lowlevel_callback);
+    LOCK_VARIABLE(queues);
     LOCK_VARIABLE(event_queue);
+    LOCK_VARIABLE(batching);
     LOCK_VARIABLE(mouse_button);
     LOCK_VARIABLE(key_table);
     LOCK_VARIABLE(timer);
+    LOCK_VARIABLE(replaying);
     LOCK_FUNCTION(alloc_event);
     LOCK_FUNCTION(free_event);
+    LOCK_FUNCTION(last_event);
     LOCK_FUNCTION(put_timer_event);
     LOCK_FUNCTION(put_mouse_event);
     LOCK_FUNCTION(put_key_event);
@@ -309,14 +449,15 @@ void awe_install_input()
 
 
 //puts an event to the event queue
-void awe_put_event(const AWE_EVENT *event)
+int awe_put_event(const AWE_EVENT *event)
 {
     AWE_EVENT *e;
 
     _lock_events();
-    e = alloc_event(&event_queue);
+    e = alloc_event(event_queue);
     if (e) *e = *event;
     _unlock_events();
+    return e != 0;
 }
 
 
@@ -327,11 +468,28 @@ AWE_EVENT_TYPE awe_get_event(AWE_EVENT *event)
 
     event->type = AWE_EVENT_NONE;
 
-    //get event from queue
-    _lock_events();
-    e = free_event(&event_queue);
-    if (e) *event = *e;
-    _unlock_events();
+    //while batching, the front queue belongs to the gui thread only
+    if (batching) {
+        e = free_event(front_queue);
+        if (e) *event = *e;
+    }
+
+    //events left in the front queue when batching stopped go first
+    else if (front_queue != event_queue && (e = free_event(front_queue)) != 0) {
+        *event = *e;
+    }
+
+    //else get event from the shared queue
+    else {
+        front_queue = event_queue;
+        _lock_events();
+        e = free_event(event_queue);
+        if (e) *event = *e;
+        _unlock_events();
+    }
+
+    //record it
+    if (record_file && e) _record_event(event);
 
     return event->type;
 }
@@ -369,6 +527,13 @@ int awe_remove_timer(void *data, int id)
 }
 
 
+//returns the time of the input clock
+unsigned awe_get_input_time()
+{
+    return _timer;
+}
+
+
 //enumerates the set timers
 void awe_enum_timers(AWE_TIMER_ENUM_PROC proc, void *data)
 {
@@ -383,15 +548,140 @@ void awe_enum_timers(AWE_TIMER_ENUM_PROC proc, void *data)
 //enumerates the event queue
 void awe_enum_events(AWE_EVENT_ENUM_PROC proc, void *data)
 {
-    AWE_EVENT *event;
-    int i;
+    if (front_queue != event_queue && !_enum_queue(front_queue, proc, data)) return;
+    _lock_events();
+    _enum_queue(event_queue, proc, data);
+    _unlock_events();
+}
+
+
+//starts the input thread and batched event delivery
+int awe_start_input_thread()
+{
+    if (batching) return 1;
 
+    //events already queued are delivered first, from the front queue; if
+    //events left by a previous batch are still there, the queues keep their roles
     _lock_events();
-    event = event_queue.event + event_queue.avail;
-    for(i = 0; i < event_queue.used; ++i) {
-        if (!proc(event, data)) break;
-        ++event;
-        if (event == event_queue.event + MAX_EVENT) event = event_queue.event;
+    if (front_queue == event_queue) {
+        event_queue = queues + (front_queue == queues);
+        memset(event_queue, 0, sizeof(QUEUE));
     }
+    batching = TRUE;
+    _unlock_events();
+
+    if (_start_input_thread(_poll_input, TIMER_BEAT)) return 1;
+    awe_stop_input_thread();
+    return 0;
+}
+
+
+//stops the input thread and batched event delivery
+void awe_stop_input_thread()
+{
+    if (!batching) return;
+    _stop_input_thread();
+
+    //undelivered events of the front queue are read before the pending
+    //ones, so as that no event is dropped if both do not fit in one queue
+    _lock_events();
+    batching = FALSE;
+    _unlock_events();
+}
+
+
+//delivers the events put since the last call
+void awe_swap_events()
+{
+    QUEUE *q;
+
+    //the previous batch must be consumed first
+    if (!batching || front_queue->used) return;
+
+    _lock_events();
+    q = front_queue;
+    front_queue = event_queue;
+    event_queue = q;
     _unlock_events();
 }
+
+
+//starts recording the events returned by awe_get_event
+int awe_start_event_recording(const char *filename)
+{
+    awe_stop_event_recording();
+    record_file = pack_fopen(filename, F_WRITE);
+    if (!record_file) return 0;
+    pack_mputl(RECORD_MAGIC, record_file);
+    pack_mputw(RECORD_VERSION, record_file);
+    record_time = _timer;
+    return 1;
+}
+
+
+//stops recording events
+void awe_stop_event_recording()
+{
+    if (!record_file) return;
+    pack_fclose(record_file);
+    record_file = 0;
+}
+
+
+//starts replaying a recorded event file
+int awe_start_event_replay(const char *filename)
+{
+    awe_stop_event_replay();
+    replay_file = pack_fopen(filename, F_READ);
+    if (!replay_file) return 0;
+    if (pack_mgetl(replay_file) != RECORD_MAGIC ||
+        pack_mgetw(replay_file) != RECORD_VERSION)
+    {
+        pack_fclose(replay_file);
+        replay_file = 0;
+        return 0;
+    }
+    replay_clock = 0;
+    replay_time = 0;
+    replaying = TRUE;
+    _next_replay_event();
+    return 1;
+}
+
+
+//stops replaying events
+void awe_stop_event_replay()
+{
+    if (!replay_file) return;
+    pack_fclose(replay_file);
+    replay_file = 0;
+    replay_pending = FALSE;
+    replaying = FALSE;
+}
+
+
+//advances the replay clock, putting the events that became due
+int awe_advance_event_replay(unsigned msecs)
+{
+    AWE_EVENT *e;
+
+    if (!replay_file) return 0;
+    replay_clock += msecs;
+
+    while (replay_pending && replay_time <= replay_clock) {
+        //leave the rest for later if the queue is full
+        _lock_events();
+        e = alloc_event(event_queue);
+        if (e) {
+            *e = replay_event;
+            e->mouse.time = replay_time;
+        }
+        _unlock_events();
+        if (!e) break;
+        _next_replay_event();
+    }
+
+    if (replay_pending) return 1;
+    awe_stop_event_replay();
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include <pthread.h>
+#include <unistd.h>
 
 
 //event lock
@@ -24,3 +25,43 @@ void _unlock_events()
 {
     pthread_mutex_unlock(&_lock);
 }
+
+
+//input thread
+static pthread_t _thread;
+static volatile int _thread_running = 0;
+static void (*_thread_proc)() = 0;
+static int _thread_msecs = 0;
+
+
+//input thread function; calls the thread proc periodically
+static void *_input_thread(void *arg)
+{
+    while (_thread_running) {
+        _thread_proc();
+        usleep(_thread_msecs * 1000);
+    }
+    return 0;
+}
+
+
+//starts the input thread
+int _start_input_thread(void (*proc)(), int msecs)
+{
+    if (_thread_running) return 1;
+    _thread_proc = proc;
+    _thread_msecs = msecs;
+    _thread_running = 1;
+    if (pthread_create(&_thread, NULL, _input_thread, NULL) == 0) return 1;
+    _thread_running = 0;
+    return 0;
+}
+
+
+//stops the input thread
+void _stop_input_thread()
+{
+    if (!_thread_running) return;
+    _thread_running = 0;
+    pthread_join(_thread, NULL);
+}
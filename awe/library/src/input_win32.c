@@ -24,3 +24,46 @@ void _unlock_events()
 {
     LeaveCriticalSection(&_lock);
 }
+
+
+//input thread
+static HANDLE _thread = 0;
+static volatile int _thread_running = 0;
+static void (*_thread_proc)() = 0;
+static int _thread_msecs = 0;
+
+
+//input thread function; calls the thread proc periodically
+static DWORD WINAPI _input_thread(LPVOID arg)
+{
+    while (_thread_running) {
+        _thread_proc();
+        Sleep(_thread_msecs);
+    }
+    return 0;
+}
+
+
+//starts the input thread
+int _start_input_thread(void (*proc)(), int msecs)
+{
+    if (_thread_running) return 1;
+    _thread_proc = proc;
+    _thread_msecs = msecs;
+    _thread_running = 1;
+    _thread = CreateThread(NULL, 0, _input_thread, NULL, 0, NULL);
+    if (_thread) return 1;
+    _thread_running = 0;
+    return 0;
+}
+
+
+//stops the input thread
+void _stop_input_thread()
+{
+    if (!_thread_running) return;
+    _thread_running = 0;
+    WaitForSingleObject(_thread, INFINITE);
+    CloseHandle(_thread);
+    _thread = 0;
+}
@@ -18,10 +18,13 @@ static void _label_constructor(AWE_OBJECT *obj)
     AWE_LABEL *tmp = (AWE_LABEL *)obj;
     tmp->text = ustrdup(empty_string);
     tmp->font = font;
+    tmp->text_width = 0;
+    tmp->text_height = text_height(font);
     memcpy(&tmp->color[AWE_LABEL_ENABLED].font_col, &_font_color_enabled, sizeof(RGB));
     memcpy(&tmp->color[AWE_LABEL_DISABLED].font_col, &_font_color_disabled, sizeof(RGB));
     memcpy(&tmp->color[AWE_LABEL_ENABLED].font_sdw, &_shadow_color_enabled, sizeof(RGB));
     memcpy(&tmp->color[AWE_LABEL_DISABLED].font_sdw, &_shadow_color_disabled, sizeof(RGB));
+    tmp->color_version = 0;
 }
 
 
@@ -39,12 +42,21 @@ static void _label_get_text(AWE_OBJECT *obj, void *data)
 }
 
 
+//measures the text; the size is kept until the text or the font changes
+static void _label_measure_text(AWE_LABEL *lbl)
+{
+    lbl->text_width = text_length(lbl->font, lbl->text);
+    lbl->text_height = text_height(lbl->font);
+}
+
+
 //sets the text
 static void _label_set_text(AWE_OBJECT *obj, void *data)
 {
     const char *new_text = *(const char **)data;
     free(((AWE_LABEL *)obj)->text);
     ((AWE_LABEL *)obj)->text = ustrdup(new_text ? new_text : empty_string);
+    _label_measure_text((AWE_LABEL *)obj);
     awe_set_widget_dirty((AWE_WIDGET *)obj);
 }
 
@@ -60,6 +72,7 @@ static void _label_get_font(AWE_OBJECT *obj, void *data)
 static void _label_set_font(AWE_OBJECT *obj, void *data)
 { 
     ((AWE_LABEL *)obj)->font = *(FONT **)data;
+    _label_measure_text((AWE_LABEL *)obj);
     awe_set_widget_dirty((AWE_WIDGET *)obj);
 }
 
@@ -75,6 +88,7 @@ static void _label_get_font_color_enabled(AWE_OBJECT *obj, void *data)
 static void _label_set_font_color_enabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_LABEL *)obj)->color[AWE_LABEL_ENABLED].font_col = *(RGB *)data;
+    ((AWE_LABEL *)obj)->color_version = 0;
     awe_set_widget_dirty((AWE_WIDGET *)obj);
 }
 
@@ -90,6 +104,7 @@ static void _label_get_font_color_disabled(AWE_OBJECT *obj, void *data)
 static void _label_set_font_color_disabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_LABEL *)obj)->color[AWE_LABEL_DISABLED].font_col = *(RGB *)data;
+    ((AWE_LABEL *)obj)->color_version = 0;
     awe_set_widget_dirty((AWE_WIDGET *)obj);
 }
 
@@ -105,6 +120,7 @@ static void _label_get_font_shadow_enabled(AWE_OBJECT *obj, void *data)
 static void _label_set_font_shadow_enabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_LABEL *)obj)->color[AWE_LABEL_ENABLED].font_sdw = *(RGB *)data;
+    ((AWE_LABEL *)obj)->color_version = 0;
     awe_set_widget_dirty((AWE_WIDGET *)obj);
 }
 
@@ -120,10 +136,25 @@ static void _label_get_font_shadow_disabled(AWE_OBJECT *obj, void *data)
 static void _label_set_font_shadow_disabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_LABEL *)obj)->color[AWE_LABEL_DISABLED].font_sdw = *(RGB *)data;
+    ((AWE_LABEL *)obj)->color_version = 0;
     awe_set_widget_dirty((AWE_WIDGET *)obj);
 }
 
 
+//makes the pixel values of the colors, if out of date
+static void _label_make_colors(AWE_LABEL *lbl)
+{
+    int i;
+
+    if (lbl->color_version == awe_get_color_version()) return;
+    for(i = 0; i < AWE_LABEL_NUM_STATES; i++) {
+        lbl->color[i].font_pix = AWE_MAKE_COLOR(lbl->color[i].font_col);
+        lbl->color[i].sdw_pix = awe_make_shadow_color(lbl->color[i].font_sdw);
+    }
+    lbl->color_version = awe_get_color_version();
+}
+
+
 //label properties
 static AWE_CLASS_PROPERTY _label_properties[] = {
     { AWE_ID_TEXT, "const char *", sizeof(const char *), _label_get_text, _label_set_text, 0 },
@@ -228,21 +259,17 @@ AWE_OBJECT *awe_label_clone(AWE_OBJECT *wgt)
 void awe_label_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *clip)
 {
     AWE_LABEL *lbl = (AWE_LABEL *)wgt;
-    if(!awe_is_enabled_widget_tree(wgt)){
-        if(AWE_MAKE_COLOR(lbl->color[AWE_LABEL_DISABLED].font_sdw) != makecol(255, 0, 255))
-            awe_draw_gui_text(canvas, lbl->font, lbl->text, 1, 1, AWE_MAKE_COLOR(lbl->color[AWE_LABEL_DISABLED].font_sdw), -1);
-        awe_draw_gui_text(canvas, lbl->font, lbl->text, 0, 0, AWE_MAKE_COLOR(lbl->color[AWE_LABEL_DISABLED].font_col), -1);
-    }
-    else{
-        if(AWE_MAKE_COLOR(lbl->color[AWE_LABEL_ENABLED].font_sdw) != makecol(255, 0, 255))
-            awe_draw_gui_text(canvas, lbl->font, lbl->text, 1, 1, AWE_MAKE_COLOR(lbl->color[AWE_LABEL_ENABLED].font_sdw), -1);
-        awe_draw_gui_text(canvas, lbl->font, lbl->text, 0, 0, AWE_MAKE_COLOR(lbl->color[AWE_LABEL_ENABLED].font_col), -1);
-    }
+    AWE_LABEL_COLOR *col = &lbl->color[awe_is_enabled_widget_tree(wgt) ? AWE_LABEL_ENABLED : AWE_LABEL_DISABLED];
+
+    _label_make_colors(lbl);
+    if(col->sdw_pix != -1)
+        awe_draw_gui_text(canvas, lbl->font, lbl->text, 1, 1, col->sdw_pix, -1);
+    awe_draw_gui_text(canvas, lbl->font, lbl->text, 0, 0, col->font_pix, -1);
 }
 
 
 void awe_label_set_geometry(AWE_WIDGET *wgt)
 {
     AWE_LABEL *lbl = (AWE_LABEL *)wgt;
-    awe_override_widget_size(wgt, text_length(lbl->font, lbl->text), text_height(lbl->font));
+    awe_override_widget_size(wgt, lbl->text_width, lbl->text_height);
 }
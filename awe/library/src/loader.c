@@ -0,0 +1,184 @@
+#include "loader.h"
+
+
+/*****************************************************************************
+    PRIVATE
+ *****************************************************************************/
+
+
+//miliseconds to wait for room in the event queue
+#define _QUEUE_WAIT          10
+
+
+//load structure
+struct AWE_LOAD {
+    AWE_LOAD_TYPE type;
+    char *path;
+    int size;
+    AWE_LOAD_PROC proc;
+    void *data;
+    void *thread;
+    void *result;
+    char *buffer;
+    int buffer_size;
+};
+
+
+//externals
+extern void *_start_load_thread(AWE_LOAD *load);
+extern void _join_load_thread(void *thread);
+extern void _lock_datafiles();
+extern void _unlock_datafiles();
+
+
+//reads a whole file into memory
+static char *_read_file(const char *path, int *size)
+{
+    PACKFILE *f;
+    char *buffer;
+
+    *size = (int)file_size_ex(path);
+    if (*size <= 0) return 0;
+    buffer = (char *)malloc(*size);
+    if (!buffer) return 0;
+    f = pack_fopen(path, F_READ);
+    if (f) {
+        if (pack_fread(buffer, *size, f) == *size) {
+            pack_fclose(f);
+            return buffer;
+        }
+        pack_fclose(f);
+    }
+    free(buffer);
+    return 0;
+}
+
+
+//creates a load and starts its thread
+static AWE_LOAD *_start_load(AWE_LOAD_TYPE type, const char *path, int size, AWE_LOAD_PROC proc, void *data)
+{
+    AWE_LOAD *load;
+
+    load = (AWE_LOAD *)calloc(1, sizeof(AWE_LOAD));
+    if (!load) return 0;
+    load->type = type;
+    load->path = ustrdup(path);
+    load->size = size;
+    load->proc = proc;
+    load->data = data;
+    if (load->path) {
+        load->thread = _start_load_thread(load);
+        if (load->thread) return load;
+    }
+    free(load->path);
+    free(load);
+    return 0;
+}
+
+
+/*****************************************************************************
+    INTERNALS
+ *****************************************************************************/
+
+
+//runs a load on its thread; the gui is not touched until the load is finished
+void _run_load(AWE_LOAD *load)
+{
+    AWE_EVENT event;
+
+    //datafiles are read one at a time, since their readers switch the color conversion of Allegro
+    switch (load->type) {
+        case AWE_LOAD_SKIN:
+            _lock_datafiles();
+            load->result = awe_read_skin(load->path);
+            _unlock_datafiles();
+            break;
+
+        case AWE_LOAD_FONT:
+            load->buffer = _read_file(load->path, &load->buffer_size);
+            break;
+
+        case AWE_LOAD_MOUSE:
+            _lock_datafiles();
+            load->result = awe_read_mouse_datafile(load->path);
+            _unlock_datafiles();
+            break;
+    }
+
+    //the completion is delivered through the event queue; wait if it is full
+    event.load.type = AWE_EVENT_LOAD;
+    event.load.time = 0;
+    event.load.load = load;
+    while (!awe_put_event(&event)) rest(_QUEUE_WAIT);
+}
+
+
+/*****************************************************************************
+    PUBLIC
+ *****************************************************************************/
+
+
+//starts loading a skin
+AWE_LOAD *awe_load_skin_async(const char *filename, AWE_LOAD_PROC proc, void *data)
+{
+    return _start_load(AWE_LOAD_SKIN, filename, 0, proc, data);
+}
+
+
+//starts loading a font
+AWE_LOAD *awe_load_font_async(const char *path, int size, AWE_LOAD_PROC proc, void *data)
+{
+    return _start_load(AWE_LOAD_FONT, path, size, proc, data);
+}
+
+
+//starts loading a cursor set
+AWE_LOAD *awe_load_mouse_async(const char *path, AWE_LOAD_PROC proc, void *data)
+{
+    return _start_load(AWE_LOAD_MOUSE, path, 0, proc, data);
+}
+
+
+//returns the type of a load
+AWE_LOAD_TYPE awe_get_load_type(AWE_LOAD *load)
+{
+    return load->type;
+}
+
+
+//cancels a load
+void awe_cancel_load(AWE_LOAD *load)
+{
+    load->proc = 0;
+}
+
+
+//finishes a load on the gui thread
+void awe_finish_load(AWE_LOAD *load)
+{
+    _join_load_thread(load->thread);
+
+    switch (load->type) {
+        case AWE_LOAD_SKIN:
+            if (!load->result) break;
+            if (load->proc) awe_load_datafile_mouse(((AWE_SKIN *)load->result)->dat);
+            else awe_unload_skin((AWE_SKIN *)load->result);
+            break;
+
+        //the font takes the buffer over
+        case AWE_LOAD_FONT:
+            if (!load->proc) free(load->buffer);
+            else load->result = load->buffer ? awe_load_font_data(load->path, load->buffer, load->buffer_size, load->size) : font;
+            break;
+
+        case AWE_LOAD_MOUSE:
+            if (!load->result) break;
+            if (load->proc) awe_adopt_mouse_datafile(load->path, (DATAFILE *)load->result);
+            else unload_datafile((DATAFILE *)load->result);
+            break;
+    }
+
+    if (load->proc) load->proc(load, load->result, load->data);
+    free(load->path);
+    free(load);
+}
@@ -0,0 +1,53 @@
+#include <pthread.h>
+#include <stdlib.h>
+
+
+//externals
+struct AWE_LOAD;
+extern void _run_load(struct AWE_LOAD *load);
+
+
+//datafile lock
+static pthread_mutex_t _lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+//locks the reading of datafiles
+void _lock_datafiles()
+{
+    pthread_mutex_lock(&_lock);
+}
+
+
+//unlocks the reading of datafiles
+void _unlock_datafiles()
+{
+    pthread_mutex_unlock(&_lock);
+}
+
+
+//load thread function
+static void *_load_thread(void *arg)
+{
+    _run_load((struct AWE_LOAD *)arg);
+    return 0;
+}
+
+
+//starts the thread of a load
+void *_start_load_thread(struct AWE_LOAD *load)
+{
+    pthread_t *thread = (pthread_t *)malloc(sizeof(pthread_t));
+
+    if (!thread) return 0;
+    if (pthread_create(thread, NULL, _load_thread, load) == 0) return thread;
+    free(thread);
+    return 0;
+}
+
+
+//waits for the thread of a load to end
+void _join_load_thread(void *thread)
+{
+    pthread_join(*(pthread_t *)thread, NULL);
+    free(thread);
+}
@@ -0,0 +1,52 @@
+#include "windows.h"
+
+
+//externals
+struct AWE_LOAD;
+extern void _run_load(struct AWE_LOAD *load);
+
+
+//datafile lock; it is installed by the gui thread when the first load starts
+static CRITICAL_SECTION _lock;
+static int _lock_installed = 0;
+
+
+//locks the reading of datafiles
+void _lock_datafiles()
+{
+    EnterCriticalSection(&_lock);
+}
+
+
+//unlocks the reading of datafiles
+void _unlock_datafiles()
+{
+    LeaveCriticalSection(&_lock);
+}
+
+
+//load thread function
+static DWORD WINAPI _load_thread(LPVOID arg)
+{
+    _run_load((struct AWE_LOAD *)arg);
+    return 0;
+}
+
+
+//starts the thread of a load
+void *_start_load_thread(struct AWE_LOAD *load)
+{
+    if (!_lock_installed) {
+        InitializeCriticalSection(&_lock);
+        _lock_installed = 1;
+    }
+    return CreateThread(NULL, 0, _load_thread, load, 0, NULL);
+}
+
+
+//waits for the thread of a load to end
+void _join_load_thread(void *thread)
+{
+    WaitForSingleObject((HANDLE)thread, INFINITE);
+    CloseHandle((HANDLE)thread);
+}
@@ -10,6 +10,10 @@
 #define MOUSE_NUM_CURSORS            32
 
 
+// Cursors that have a default sprite
+#define MOUSE_NUM_DEFAULT            14
+
+
 #define MOUSE_OFFSCREEN              -4096
 #define MOUSE_DEFAULT_FOCUSX         1
 #define MOUSE_DEFAULT_FOCUSY         1
@@ -18,6 +22,7 @@
 #define MOUSE_DEFAULT_FOCUS          1
 #define MOUSE_SCARED_SIZE            16          /* for unscare_mouse() */
 #define MOUSE_DEFAULT_INTENSITY      140         /* default shadow intensity */
+#define MOUSE_SHADOW_CACHE           64          /* unused shadows kept for reuse */
 
 
 //cursor structure
@@ -36,6 +41,21 @@ struct AWE_CURSOR {
 }; 
 
 
+// cached shadow; cursor frames drawn from the same pixels with the same shadow settings share it
+typedef struct _shadow_entry {
+    unsigned char *pixels;
+    int w;
+    int h;
+    int alpha;
+    int intensity;
+    int focus;
+    BITMAP *shadow;
+    int refs;
+    unsigned used;
+    struct _shadow_entry *next;
+} _SHADOW_ENTRY;
+
+
 typedef struct _default_cursor {
     unsigned char *cursor;
     int hotx;
@@ -52,6 +72,10 @@ static void _timer(void){
 }END_OF_FUNCTION(_timer);
 
 
+// The timer runs only while the current cursor is animated
+static int _mouse_timer_installed = FALSE;
+
+
 static AWE_CURSOR *_cursor[MOUSE_NUM_CURSORS];
 
 
@@ -72,6 +96,18 @@ static BITMAP *_shadow_bg = NULL;
 static BITMAP *_mouse_vid_screen = NULL;
 
 
+// Scratch bitmap the cursor is composited on when the mouse screen is presented
+static BITMAP *_overlay_bmp = NULL;
+
+
+// Area of the video screen the cursor was last presented on, and the bitmap it was composited over
+static BITMAP *_drawn_screen = NULL;
+static int _drawn_x = 0;
+static int _drawn_y = 0;
+static int _drawn_w = 0;
+static int _drawn_h = 0;
+
+
 static int _shadow_offsetx = MOUSE_DEFAULT_OFFSETX;
 static int _shadow_offsety = MOUSE_DEFAULT_OFFSETY;
 static int _shadow_intensity = MOUSE_DEFAULT_INTENSITY;
@@ -79,6 +115,11 @@ static int _shadow_focus = MOUSE_DEFAULT_FOCUS;
 static int _show_shadow = TRUE;
 
 
+static _SHADOW_ENTRY *_shadow_cache = NULL;
+static int _shadow_unused = 0;
+static unsigned _shadow_clock = 0;
+
+
 static AWE_CURSOR *_current_cur = NULL;
 
 
@@ -90,6 +131,11 @@ static int _scared_freeze[MOUSE_SCARED_SIZE];
 static int _scared_size = 0;
 
 
+// Default cursor sprites, baked side by side into one bitmap
+static BITMAP *_default_sprites = NULL;
+static BITMAP *_default_sprite[MOUSE_NUM_DEFAULT];
+
+
 // Current cursor path
 static char *_cursor_path = NULL;
 
@@ -509,132 +555,314 @@ static _DEFAULT_CURSOR _default_cursor[] = {
 };
 
 
-//creates a cursor from a default cursor array
-static BITMAP *_create_mouse_sprite(unsigned char *cursor){
-    BITMAP *bmp;
-    int x, y, col;
-    bmp = create_bitmap(cursor[0], cursor[1]);
-    if(!bmp){
-        TRACE("Mouse: Failed to Allocate Memory\n");
-        return NULL;
+/* Blurs an alpha plane into a shadow bitmap. The box filter is separable, so
+   the window sums run along the rows, then down the columns, each updated
+   by one value in and one out per pixel.
+ */
+static int _blur_shadow(BITMAP *bmp, int *plane, int radius) {
+    int *row, *col;
+    int x, y, sum, a;
+    int w = bmp->w, h = bmp->h;
+    int div = (2 * radius + 1) * (2 * radius + 1);
+    uint32_t mask = makeacol32(255, 0, 255, 0);
+    uint32_t *dest;
+    row = (int*)malloc(w * sizeof(int));
+    col = (int*)calloc(w, sizeof(int));
+    if(!row || !col){
+        free(row);
+        free(col);
+        return 0;
     }
-    for(y = 0; y < cursor[1]; y++){
-        for(x = 0; x < cursor[0]; x++){
-            switch(cursor[(y * cursor[0]) + x + 2]){
-                case 1:  
-                    col = makecol(0, 0, 0);  
-                break;
-                case 2:
-                    col = makecol(255, 255, 255);        
-                break;
-                default: 
-                    col = bmp->vtable->mask_color; 
-                break;
-            }
-            putpixel(bmp, x, y, col);
+    /* Rows are replaced by the sums of their windows */
+    for (y = 0; y < h; y++) {
+        memcpy(row, plane + y * w, w * sizeof(int));
+        sum = 0;
+        for (x = 0; x < w && x <= radius; x++)
+            sum += row[x];
+        for (x = 0; x < w; x++) {
+            plane[y * w + x] = sum;
+            if(x + radius + 1 < w)
+                sum += row[x + radius + 1];
+            if(x - radius >= 0)
+                sum -= row[x - radius];
         }
     }
-    return bmp;
-}
-
-
-// Blurs the shadow using its alpha channel
-static void _blur_shadow(BITMAP *bmp, int radius) {
-    BITMAP *tmp;
-    int x, y, i, j;
-    int src, dest;
-    int a;
-    int div = (2 * radius + 1) * (2 * radius + 1);
-    tmp = create_bitmap_ex(32, bmp->w + 2 * radius, bmp->h + 2 * radius);
-    if(!tmp)
-        return;
-    clear(tmp);
-    blit(bmp, tmp, 0, 0, radius, radius, bmp->w, bmp->h);
-    for (y = radius; y < tmp->h - radius; y++) {
-        for (x = radius; x < tmp->w - radius; x++) {
-            a = 0;
-            for (j =- radius; j <= radius; j++) {
-                for (i =- radius; i <= radius; i++) {
-                    src = getpixel(tmp, x + i, y + j);
-                    a += geta32(src);
-                }
-            }
-            if((a / div) > 0)
-                dest = makeacol32(0, 0, 0, (a / div));
-            else
-                dest = makeacol32(255, 0, 255, 0);
-            putpixel(bmp, x - radius, y - radius, dest);
+    /* Columns keep the sums of their windows while going down */
+    for (y = 0; y < h && y <= radius; y++) {
+        for (x = 0; x < w; x++)
+            col[x] += plane[y * w + x];
+    }
+    for (y = 0; y < h; y++) {
+        dest = (uint32_t*)bmp->line[y];
+        for (x = 0; x < w; x++) {
+            a = col[x] / div;
+            dest[x] = a > 0 ? (uint32_t)makeacol32(0, 0, 0, a) : mask;
+        }
+        for (x = 0; x < w; x++) {
+            if(y + radius + 1 < h)
+                col[x] += plane[(y + radius + 1) * w + x];
+            if(y - radius >= 0)
+                col[x] -= plane[(y - radius) * w + x];
         }
     }
-    destroy_bitmap(tmp);
+    free(row);
+    free(col);
+    return 1;
 }
 
 
 // Creates a cursor shadow from a cursor bitmap
 static BITMAP *_create_shadow(BITMAP *bmp, int alpha) {
-    int x, y, a, pink;
+    int x, y, a, c, pink, raw;
+    int *plane;
     BITMAP *shdw;
     // shadow is a 32 bit RGBA bitmap
     if((shdw = create_bitmap_ex(32, bmp->w + 2 * _shadow_focus, bmp->h + 2 * _shadow_focus)) == NULL)
         return NULL;
-    clear(shdw);
-    if(alpha){
-        for (y = 0; y < bmp->h; y++) {
-            for (x = 0; x < bmp->w; x++) {
-                a = geta32(getpixel(bmp, x, y));
-                putpixel(shdw, x + _shadow_focus, y + _shadow_focus, makeacol32(0, 0, 0, MAX(a - (255 - _shadow_intensity), 0)));
+    // the alpha of the shadow is laid out in a plane, bordered by the blur radius
+    if((plane = (int*)calloc(shdw->w * shdw->h, sizeof(int))) == NULL){
+        destroy_bitmap(shdw);
+        return NULL;
+    }
+    raw = is_memory_bitmap(bmp) && bitmap_color_depth(bmp) == 32;
+    pink = makecol(255,0,255);
+    for (y = 0; y < bmp->h; y++) {
+        for (x = 0; x < bmp->w; x++) {
+            c = raw ? (int)((uint32_t*)bmp->line[y])[x] : getpixel(bmp, x, y);
+            if(alpha)
+                a = MAX(geta32(c) - (255 - _shadow_intensity), 0);
+            else
+                a = c != pink ? _shadow_intensity : 0;
+            plane[(y + _shadow_focus) * shdw->w + x + _shadow_focus] = a;
+        }
+    }
+    if(!_blur_shadow(shdw, plane, _shadow_focus)){
+        destroy_bitmap(shdw);
+        shdw = NULL;
+    }
+    free(plane);
+    return shdw;
+}
+
+
+// Destroys the least recently released shadows beyond the cache limit
+static void _trim_shadows(void){
+    _SHADOW_ENTRY **prev, **lru, *entry;
+    while(_shadow_unused > MOUSE_SHADOW_CACHE){
+        lru = NULL;
+        for(prev = &_shadow_cache; *prev; prev = &(*prev)->next){
+            if((*prev)->refs)
+                continue;
+            if(!lru || _shadow_clock - (*prev)->used > _shadow_clock - (*lru)->used)
+                lru = prev;
+        }
+        if(!lru)
+            return;
+        entry = *lru;
+        *lru = entry->next;
+        destroy_bitmap(entry->shadow);
+        free(entry);
+        _shadow_unused--;
+    }
+}
+
+
+// Returns the shadow of a cursor bitmap for the current shadow settings
+static BITMAP *_get_shadow(BITMAP *src, int alpha){
+    _SHADOW_ENTRY *entry;
+    for(entry = _shadow_cache; entry; entry = entry->next){
+        if(entry->pixels == src->line[0] && entry->w == src->w && entry->h == src->h && entry->alpha == alpha && entry->intensity == _shadow_intensity && entry->focus == _shadow_focus){
+            if(!entry->refs++)
+                _shadow_unused--;
+            return entry->shadow;
+        }
+    }
+    if((entry = (_SHADOW_ENTRY*)malloc(sizeof(_SHADOW_ENTRY))) == NULL)
+        return NULL;
+    if((entry->shadow = _create_shadow(src, alpha)) == NULL){
+        free(entry);
+        return NULL;
+    }
+    entry->pixels = src->line[0];
+    entry->w = src->w;
+    entry->h = src->h;
+    entry->alpha = alpha;
+    entry->intensity = _shadow_intensity;
+    entry->focus = _shadow_focus;
+    entry->refs = 1;
+    entry->used = 0;
+    entry->next = _shadow_cache;
+    _shadow_cache = entry;
+    return entry->shadow;
+}
+
+
+// Releases a shadow returned by _get_shadow; it is kept for reuse
+static void _release_shadow(BITMAP *shadow){
+    _SHADOW_ENTRY *entry;
+    if(!shadow)
+        return;
+    for(entry = _shadow_cache; entry; entry = entry->next){
+        if(entry->shadow == shadow){
+            if(!--entry->refs){
+                entry->used = ++_shadow_clock;
+                _shadow_unused++;
+                _trim_shadows();
             }
+            return;
+        }
+    }
+}
+
+
+// Destroys the released shadows of a cursor bitmap that is going away
+static void _purge_shadows(BITMAP *src){
+    _SHADOW_ENTRY **prev, *entry;
+    for(prev = &_shadow_cache; (entry = *prev); ){
+        if(entry->pixels == src->line[0] && entry->w == src->w && entry->h == src->h && !entry->refs){
+            *prev = entry->next;
+            destroy_bitmap(entry->shadow);
+            free(entry);
+            _shadow_unused--;
+            continue;
         }
+        prev = &entry->next;
     }
+}
+
+
+// Releases the shadows of a cursor; frames may share the shadow of the first one
+static void _release_cursor_shadows(AWE_CURSOR *cursor){
+    int j;
+    if(cursor->num_frames > 1 && cursor->shadow[0] == cursor->shadow[1])
+        _release_shadow(cursor->shadow[0]);
     else{
-        pink = makecol(255,0,255);
-        for (y = 0; y < bmp->h; y++) {
-            for (x = 0; x < bmp->w; x++) {
-                if(getpixel(bmp, x, y) != pink)
-                    a = makeacol32(0, 0, 0, _shadow_intensity);
-                else
-                    a = makeacol32(0, 0, 0, 0);
-                putpixel(shdw, x + _shadow_focus, y + _shadow_focus, a);
-            }
+        for(j = 0; j < cursor->num_frames; j++)
+            _release_shadow(cursor->shadow[j]);
+    }
+    for(j = 0; j < cursor->num_frames; j++)
+        cursor->shadow[j] = NULL;
+}
+
+
+// Sets the shadows of a cursor from the cache; shared sets the shadow of the first frame to all frames
+static int _get_cursor_shadows(AWE_CURSOR *cursor, int shared){
+    int j, alpha = cursor->cur_trans == AWE_MOUSE_TRANS_ALPHA;
+    for(j = 0; j < cursor->num_frames; j++){
+        if(shared && j != 0)
+            cursor->shadow[j] = cursor->shadow[0];
+        else if((cursor->shadow[j] = _get_shadow(cursor->cur[j], alpha)) == NULL)
+            return 0;
+    }
+    return 1;
+}
+
+
+// Writes a row of a default cursor array to a bitmap line
+static void _write_sprite_row(unsigned long addr, int depth, const unsigned char *row, int w, const int *col){
+    int x;
+    switch(depth){
+        case 8:
+            for(x = 0; x < w; x++)
+                bmp_write8(addr + x, col[row[x]]);
+        break;
+        case 15:
+            for(x = 0; x < w; x++)
+                bmp_write15(addr + x * 2, col[row[x]]);
+        break;
+        case 16:
+            for(x = 0; x < w; x++)
+                bmp_write16(addr + x * 2, col[row[x]]);
+        break;
+        case 24:
+            for(x = 0; x < w; x++)
+                bmp_write24(addr + x * 3, col[row[x]]);
+        break;
+        case 32:
+            for(x = 0; x < w; x++)
+                bmp_write32(addr + x * 4, col[row[x]]);
+        break;
+    }
+}
+
+
+// Returns TRUE if a bitmap shares its pixels with the default cursor sprites
+static int _is_default_sprite(BITMAP *bmp){
+    int ofs;
+    if(!_default_sprites)
+        return FALSE;
+    ofs = bmp->line[0] - _default_sprites->line[0];
+    return ofs >= 0 && ofs < _default_sprites->w * BYTES_PER_PIXEL(bitmap_color_depth(_default_sprites));
+}
+
+
+// Destroys the default cursor sprites and their released shadows
+static void _destroy_default_sprites(void){
+    int i;
+    for(i = 0; i < MOUSE_NUM_DEFAULT; i++){
+        if(_default_sprite[i]){
+            _purge_shadows(_default_sprite[i]);
+            destroy_bitmap(_default_sprite[i]);
+            _default_sprite[i] = NULL;
         }
     }
-    _blur_shadow(shdw, _shadow_focus);
-    return shdw;
+    if(_default_sprites){
+        destroy_bitmap(_default_sprites);
+        _default_sprites = NULL;
+    }
+}
+
+
+/* Bakes the default cursor arrays side by side into one bitmap of the current
+   color depth, writing the rows straight to memory. The sprites are kept for
+   the cursor sets loaded later, until the color depth changes.
+ */
+static int _bake_default_sprites(void){
+    int i, y, x = 0, w = 0, h = 0, depth = get_color_depth();
+    int col[3];
+    unsigned char *cursor;
+    if(_default_sprites && bitmap_color_depth(_default_sprites) == depth)
+        return 1;
+    _destroy_default_sprites();
+    for(i = 0; i < MOUSE_NUM_DEFAULT; i++){
+        w += _default_cursor[i].cursor[0];
+        h = MAX(h, _default_cursor[i].cursor[1]);
+    }
+    if((_default_sprites = create_bitmap(w, h)) == NULL){
+        TRACE("Mouse: Failed to Allocate Memory\n");
+        return 0;
+    }
+    col[0] = bitmap_mask_color(_default_sprites);
+    col[1] = makecol(0, 0, 0);
+    col[2] = makecol(255, 255, 255);
+    bmp_select(_default_sprites);
+    for(i = 0; i < MOUSE_NUM_DEFAULT; i++){
+        cursor = _default_cursor[i].cursor;
+        for(y = 0; y < cursor[1]; y++)
+            _write_sprite_row(bmp_write_line(_default_sprites, y) + x * BYTES_PER_PIXEL(depth), depth, cursor + 2 + y * cursor[0], cursor[0], col);
+        if((_default_sprite[i] = create_sub_bitmap(_default_sprites, x, 0, cursor[0], cursor[1])) == NULL){
+            bmp_unwrite_line(_default_sprites);
+            TRACE("Mouse: Failed to Allocate Memory\n");
+            _destroy_default_sprites();
+            return 0;
+        }
+        x += cursor[0];
+    }
+    bmp_unwrite_line(_default_sprites);
+    return 1;
 }
 
 
 // Rebuilds the shadow array for a single cursor
 static int _rebuild_cursor_shadow(AWE_CURSOR *cursor){
-    int j;
+    int shared;
     if(!cursor)
         return 0;
     if(cursor->shadow){
-        if(cursor->num_frames > 1 && cursor->shadow[0] == cursor->shadow[1]){
-            destroy_bitmap(cursor->shadow[0]);
-            if(cursor->cur_trans == AWE_MOUSE_TRANS_ALPHA){
-                if((cursor->shadow[0] = _create_shadow(cursor->cur[0], TRUE)) == NULL)
-                    return 0;
-            }
-            else{
-                if((cursor->shadow[0] = _create_shadow(cursor->cur[0], FALSE)) == NULL)
-                    return 0;
-            }
-            for(j = 1; j < cursor->num_frames; j++)
-                cursor->shadow[j] = cursor->shadow[0];
-        }
-        else{
-            for(j = 0; j < cursor->num_frames; j++){
-                destroy_bitmap(cursor->shadow[j]);
-                if(cursor->cur_trans == AWE_MOUSE_TRANS_ALPHA){
-                    if((cursor->shadow[j] = _create_shadow(cursor->cur[j], TRUE)) == NULL)
-                        return 0;
-                }
-                else{
-                    if((cursor->shadow[j] = _create_shadow(cursor->cur[j], FALSE)) == NULL)
-                        return 0;
-                }
-            }
-        }
+        shared = cursor->num_frames > 1 && cursor->shadow[0] == cursor->shadow[1];
+        _release_cursor_shadows(cursor);
+        if(!_get_cursor_shadows(cursor, shared))
+            return 0;
         if(cursor == _current_cur && _shadow_bg){
             destroy_bitmap(_shadow_bg);
             _shadow_bg = create_bitmap(cursor->shadow[0]->w, cursor->shadow[0]->h);
@@ -657,9 +885,28 @@ static void _rebuild_shadows(void){
 }
 
 
-// Helper function for drawing and hiding the mouse
+// Draws the shadow and the cursor with the cursor's hot spot at the given position
+static void _draw_cursor(BITMAP *bmp, int x, int y){
+    int cur_frame = _current_cur->cur_frame;
+    if(_current_cur->shadow && _show_shadow){
+        set_alpha_blender();
+        draw_trans_sprite(bmp, _current_cur->shadow[cur_frame], x + _shadow_offsetx - _shadow_focus - _current_cur->hotx, y + _shadow_offsety - _shadow_focus - _current_cur->hoty);
+    }
+    if(_current_cur->cur_trans == AWE_MOUSE_TRANS_ALPHA){
+        set_alpha_blender();
+        draw_trans_sprite(bmp, _current_cur->cur[cur_frame], x - _current_cur->hotx, y - _current_cur->hoty);
+    }
+    else if(_current_cur->cur_trans != 0){
+        set_trans_blender(0, 0, 0, _current_cur->cur_trans); 
+        draw_trans_sprite(bmp, _current_cur->cur[cur_frame], x - _current_cur->hotx, y - _current_cur->hoty);
+    }    
+    else
+        draw_sprite(bmp, _current_cur->cur[cur_frame], x - _current_cur->hotx, y - _current_cur->hoty);
+}
+
+
+// Helper function for drawing and hiding the mouse when it is drawn straight onto the video screen
 static void _draw_mouse(int remove, int add){
-    int cur_frame;
     if(!_mouse_screen)
         return;
     if(!_current_cur)
@@ -670,24 +917,146 @@ static void _draw_mouse(int remove, int add){
         blit(_mouse_bg, _mouse_screen, 0, 0, _old_mx - _current_cur->hotx, _old_my - _current_cur->hoty, _mouse_bg->w, _mouse_bg->h);
     }
     if (add) {
-        cur_frame = _current_cur->cur_frame;
         if(_current_cur->shadow)
             blit(_mouse_screen, _shadow_bg, _mx - _current_cur->hotx - _shadow_focus + _shadow_offsetx, _my - _current_cur->hoty - _shadow_focus + _shadow_offsety, 0, 0, _shadow_bg->w, _shadow_bg->h);
         blit(_mouse_screen, _mouse_bg, _mx - _current_cur->hotx, _my - _current_cur->hoty, 0, 0, _mouse_bg->w, _mouse_bg->h);
-        if(_current_cur->shadow && _show_shadow){
-            set_alpha_blender();
-            draw_trans_sprite(_mouse_screen, _current_cur->shadow[cur_frame], _mx + _shadow_offsetx - _shadow_focus - _current_cur->hotx, _my + _shadow_offsety - _shadow_focus - _current_cur->hoty);
-        }
-        if(_current_cur->cur_trans == AWE_MOUSE_TRANS_ALPHA){
-            set_alpha_blender();
-            draw_trans_sprite(_mouse_screen, _current_cur->cur[cur_frame], _mx - _current_cur->hotx, _my - _current_cur->hoty);
-        }
-        else if(_current_cur->cur_trans != 0){
-            set_trans_blender(0, 0, 0, _current_cur->cur_trans); 
-            draw_trans_sprite(_mouse_screen, _current_cur->cur[cur_frame], _mx - _current_cur->hotx, _my - _current_cur->hoty);
-        }    
-        else
-            draw_sprite(_mouse_screen, _current_cur->cur[cur_frame], _mx - _current_cur->hotx, _my - _current_cur->hoty);
+        _draw_cursor(_mouse_screen, _mx, _my);
+    }
+}
+
+
+// Returns 1 if a bounding box collision is detected, 0 otherwise
+static int _mouse_collision(int x1, int y1, int w1, int h1, int x2, int y2, int w2, int h2){
+        if(y1 + h1 <= y2) 
+            return 0;
+        if(y1 >= y2 + h2) 
+            return 0;
+        if(x1 + w1 <= x2) 
+            return 0;
+        if(x1 >= x2 + w2) 
+               return 0;
+        return 1;
+}
+
+
+// Returns TRUE if the cursor is composited over the mouse screen as it is presented to the video screen
+static int _mouse_overlay(void){
+    return _mouse_screen && _current_cur && _mouse_screen != _mouse_vid_screen;
+}
+
+
+// Gets the area the cursor and its shadow cover with the cursor's hot spot at the given position
+static int _get_cursor_area(int mx, int my, int *x, int *y, int *w, int *h){
+    int x2, y2;
+    if(!_current_cur){
+        *x = *y = *w = *h = 0;
+        return 0;
+    }
+    *x = mx - _current_cur->hotx;
+    *y = my - _current_cur->hoty;
+    x2 = *x + _current_cur->cur[0]->w;
+    y2 = *y + _current_cur->cur[0]->h;
+    if(_current_cur->shadow && _show_shadow){
+        *x = MIN(*x, mx + _shadow_offsetx - _shadow_focus - _current_cur->hotx);
+        *y = MIN(*y, my + _shadow_offsety - _shadow_focus - _current_cur->hoty);
+        x2 = MAX(x2, mx + _shadow_offsetx - _shadow_focus - _current_cur->hotx + _current_cur->shadow[0]->w);
+        y2 = MAX(y2, my + _shadow_offsety - _shadow_focus - _current_cur->hoty + _current_cur->shadow[0]->h);
+    }
+    *w = x2 - *x;
+    *h = y2 - *y;
+    return 1;
+}
+
+
+// Makes sure the scratch bitmap can hold an area of the mouse screen
+static int _get_overlay_bmp(int w, int h){
+    int depth = bitmap_color_depth(_mouse_screen);
+    if(_overlay_bmp && _overlay_bmp->w >= w && _overlay_bmp->h >= h && bitmap_color_depth(_overlay_bmp) == depth)
+        return 1;
+    if(_overlay_bmp){
+        w = MAX(w, _overlay_bmp->w);
+        h = MAX(h, _overlay_bmp->h);
+        destroy_bitmap(_overlay_bmp);
+    }
+    _overlay_bmp = create_bitmap_ex(depth, w, h);
+    return _overlay_bmp != NULL;
+}
+
+
+// Copies an area of a bitmap to the video screen, compositing the cursor over the part it covers
+static void _present_area(BITMAP *bmp, int x, int y, int w, int h){
+    int cx, cy, cw, ch, ix, iy, iw, ih;
+    if(w <= 0 || h <= 0)
+        return;
+    if(bmp != _mouse_screen || !_mouse_overlay() || !_get_cursor_area(_mx, _my, &cx, &cy, &cw, &ch) || !_mouse_collision(x, y, w, h, cx, cy, cw, ch)){
+        blit(bmp, _mouse_vid_screen, x, y, x, y, w, h);
+        return;
+    }
+    ix = MAX(x, cx);
+    iy = MAX(y, cy);
+    iw = MIN(x + w, cx + cw) - ix;
+    ih = MIN(y + h, cy + ch) - iy;
+    /* Copy the parts around the cursor as they are, so as that no pixel is presented twice */
+    blit(bmp, _mouse_vid_screen, x, y, x, y, w, iy - y);
+    blit(bmp, _mouse_vid_screen, x, iy + ih, x, iy + ih, w, y + h - iy - ih);
+    blit(bmp, _mouse_vid_screen, x, iy, x, iy, ix - x, ih);
+    blit(bmp, _mouse_vid_screen, ix + iw, iy, ix + iw, iy, x + w - ix - iw, ih);
+    /* Compose the part under the cursor on the scratch bitmap */
+    if(!_get_overlay_bmp(iw, ih)){
+        blit(bmp, _mouse_vid_screen, ix, iy, ix, iy, iw, ih);
+        return;
+    }
+    blit(bmp, _overlay_bmp, ix, iy, 0, 0, iw, ih);
+    set_clip_rect(_overlay_bmp, 0, 0, iw - 1, ih - 1);
+    _draw_cursor(_overlay_bmp, _mx - ix, _my - iy);
+    blit(_overlay_bmp, _mouse_vid_screen, 0, 0, ix, iy, iw, ih);
+}
+
+
+// Presents the area the cursor was on and the area it is on now
+static void _update_overlay(void){
+    int x, y, w, h, x2, y2;
+    BITMAP *bmp = _mouse_overlay() ? _mouse_screen : NULL;
+    if(bmp)
+        _get_cursor_area(_mx, _my, &x, &y, &w, &h);
+    else
+        x = y = w = h = 0;
+    if(!_mouse_vid_screen || (!_drawn_screen && !bmp))
+        return;
+    acquire_bitmap(_mouse_vid_screen);
+    /* Areas that overlap are presented at once, so as that the cursor does not flicker */
+    if(_drawn_screen == bmp && _mouse_collision(_drawn_x, _drawn_y, _drawn_w, _drawn_h, x, y, w, h)){
+        x2 = MAX(_drawn_x + _drawn_w, x + w);
+        y2 = MAX(_drawn_y + _drawn_h, y + h);
+        _drawn_x = MIN(_drawn_x, x);
+        _drawn_y = MIN(_drawn_y, y);
+        _present_area(bmp, _drawn_x, _drawn_y, x2 - _drawn_x, y2 - _drawn_y);
+    }
+    else{
+        if(_drawn_screen)
+            _present_area(_drawn_screen, _drawn_x, _drawn_y, _drawn_w, _drawn_h);
+        if(bmp)
+            _present_area(bmp, x, y, w, h);
+    }
+    release_bitmap(_mouse_vid_screen);
+    _drawn_screen = bmp;
+    _drawn_x = x;
+    _drawn_y = y;
+    _drawn_w = w;
+    _drawn_h = h;
+}
+
+
+// Installs or removes the timer, as the current cursor needs it
+static void _update_mouse_timer(void){
+    int animated = _current_cur && _current_cur->num_frames > 1 && _current_cur->speed > 0;
+    if(animated && !_mouse_timer_installed){
+        install_int_ex(_timer, BPS_TO_TIMER(60));
+        _mouse_timer_installed = TRUE;
+    }
+    else if(!animated && _mouse_timer_installed){
+        remove_int(_timer);
+        _mouse_timer_installed = FALSE;
     }
 }
 
@@ -716,20 +1085,6 @@ static int _get_dat_int(DATAFILE *dat, int idx, int prop, int val){
 }
 
 
-// Returns 1 if a bounding box collision is detected, 0 otherwise
-static int _mouse_collision(int x1, int y1, int w1, int h1, int x2, int y2, int w2, int h2){
-        if(y1 + h1 <= y2) 
-            return 0;
-        if(y1 >= y2 + h2) 
-            return 0;
-        if(x1 + w1 <= x2) 
-            return 0;
-        if(x1 >= x2 + w2) 
-               return 0;
-        return 1;
-}
-
-
 // destroys a mouse cursor
 static void _destroy_mouse_cursor(AWE_CURSOR *cursor){
     int j;
@@ -746,25 +1101,19 @@ static void _destroy_mouse_cursor(AWE_CURSOR *cursor){
             }
         }
     }
+    if(cursor->shadow){
+        _release_cursor_shadows(cursor);
+        free(cursor->shadow);
+    }
     if(cursor->cur){
         for(j = 0; j < cursor->num_frames; j++){
-            if(cursor->cur[j])
+            if(cursor->cur[j]){
+                if(!_is_default_sprite(cursor->cur[j]))
+                    _purge_shadows(cursor->cur[j]);
                 destroy_bitmap(cursor->cur[j]);
-        }
-        free(cursor->cur);
-    }
-    if(cursor->shadow){
-        if(cursor->num_frames > 1 && cursor->shadow[0] == cursor->shadow[1]){
-            if(cursor->shadow[0])
-                destroy_bitmap(cursor->shadow[0]);
-        }
-        else{
-            for(j = 0; j < cursor->num_frames; j++){
-                if(cursor->shadow[j])
-                    destroy_bitmap(cursor->shadow[j]);
             }
         }
-        free(cursor->shadow);
+        free(cursor->cur);
     }
     free(cursor);
 }
@@ -787,10 +1136,10 @@ static AWE_CURSOR *_create_mouse_cursor(BITMAP *cursor, int type, int hotx, int
     tmp->cur_frame = 0;
     tmp->timer = 0;
     width = cursor->w / num_frames;
-    if((tmp->cur = malloc(num_frames * sizeof(BITMAP*))) == NULL)
+    if((tmp->cur = calloc(num_frames, sizeof(BITMAP*))) == NULL)
 	goto _cursor_error;
     if(shadowed){
-        if((tmp->shadow = malloc(num_frames * sizeof(BITMAP*))) == NULL)
+        if((tmp->shadow = calloc(num_frames, sizeof(BITMAP*))) == NULL)
             goto _cursor_error;
     }
     else
@@ -798,31 +1147,9 @@ static AWE_CURSOR *_create_mouse_cursor(BITMAP *cursor, int type, int hotx, int
     for(j = 0; j < num_frames; j++){
         if((tmp->cur[j] = create_sub_bitmap(cursor, j * width, 0, width, cursor->h)) == NULL)
             goto _cursor_error;
-        if(tmp->shadow){
-            if(shadow_method && j == 0){
-                if(tmp->cur_trans == AWE_MOUSE_TRANS_ALPHA){
-                    if((tmp->shadow[j] = _create_shadow(tmp->cur[j], TRUE)) == NULL)
-                        goto _cursor_error;
-                }
-                else{
-                    if((tmp->shadow[j] = _create_shadow(tmp->cur[j], FALSE)) == NULL)
-                        goto _cursor_error;
-                }
-            }
-            else if(shadow_method && j != 0)
-                tmp->shadow[j] = tmp->shadow[0];
-            else{
-                if(tmp->cur_trans == AWE_MOUSE_TRANS_ALPHA){
-                    if((tmp->shadow[j] = _create_shadow(tmp->cur[j], TRUE)) == NULL)
-                        goto _cursor_error;
-                }
-                else{
-                   if((tmp->shadow[j] = _create_shadow(tmp->cur[j], FALSE)) == NULL)
-                        goto _cursor_error;
-                }
-            }
-        }
     }
+    if(tmp->shadow && !_get_cursor_shadows(tmp, shadow_method))
+        goto _cursor_error;
     if(type == AWE_MOUSE_USER){
         AWE_DL_DATA_NODE *user_cursor = (AWE_DL_DATA_NODE*)malloc(sizeof(AWE_DL_DATA_NODE));
         if(!user_cursor)
@@ -860,6 +1187,10 @@ static void _destroy_mouse(){
         destroy_bitmap(_shadow_bg);
         _shadow_bg = NULL;
     }
+    if(_overlay_bmp){
+        destroy_bitmap(_overlay_bmp);
+        _overlay_bmp = NULL;
+    }
     if(_cursor_path){
         free(_cursor_path);
         _cursor_path = NULL;
@@ -893,98 +1224,40 @@ void awe_destroy_mouse_cursor(AWE_CURSOR *cursor){
 
 // Loads a mouse datafile and initializes all the cursor and shadow arrays
 int awe_load_mouse(const char *path){
-    int i, alpha = 0, shadowed = 0, shadow_method = 0, default_shadow = 0, default_trans = 0, ext, idx = 0;
-    int hotx, hoty, anim_type, speed, num_frames, cur_trans;
-    char buffer[1024];
-    BITMAP *tmp;
-    if(path){
-        if((_cursor_path != NULL) && (ustricmp(path, _cursor_path) == 0))
-            return 1;
-        if(_cursor_path != NULL)
-	    free(_cursor_path);
-        if((_cursor_path = malloc((ustrlen(path) + uwidth_max(U_CURRENT)) * uwidth_max(U_CURRENT))) == NULL)
-            return 0;
-        ustrcpy(_cursor_path, path);
-    }
-    _destroy_mouse();
-    /* Check to see if the cursor set contains an alpha channel */
-    if(path){
-        _mouse = load_datafile(path);
-        if(_mouse){
-            idx = _get_dat_idx(_mouse, "ALPHA_CFG");
-            alpha = _get_dat_int(_mouse, idx, DAT_ID('C', 'F', 'G', 'A'), 0);
-        }
+    if(path && _cursor_path && ustricmp(path, _cursor_path) == 0)
+        return 1;
+    return awe_adopt_mouse_datafile(path, path ? awe_read_mouse_datafile(path) : NULL);
+}
+
+
+// Reads a mouse datafile, converting colors if the cursor set has an alpha channel
+DATAFILE *awe_read_mouse_datafile(const char *path){
+    DATAFILE *dat, *cfg;
+    const char *tmp;
+    int alpha = 0;
+    /* Read the alpha configuration alone, so as that the datafile is loaded once */
+    if((cfg = load_datafile_object(path, "ALPHA_CFG")) != NULL){
+        tmp = get_datafile_property(cfg, DAT_ID('C', 'F', 'G', 'A'));
+        alpha = *tmp == '\0' ? 0 : atoi(tmp);
+        unload_datafile_object(cfg);
     }
     /* Set color conversion if alpha channel is present */
-    if(alpha){
-        /* Alpha is true so we must reload the datafile with color conversion */
-        unload_datafile(_mouse);
+    if(alpha)
         set_color_conversion(COLORCONV_EXPAND_HI_TO_TRUE);
-        /* Reload the datafile */
-        _mouse = load_datafile(path);
-    }
-    if(_mouse){
-        idx = _get_dat_idx(_mouse, "CURSOR");
-        default_trans = _get_dat_int(_mouse, idx, DAT_ID('C', 'U', 'R', 'T'), 0);
-        idx = _get_dat_idx(_mouse, "SHADOW");
-        _shadow_intensity = _get_dat_int(_mouse, idx, DAT_ID('S', 'D', 'W', 'I'), MOUSE_DEFAULT_INTENSITY);
-        _shadow_offsetx = _get_dat_int(_mouse, idx, DAT_ID('S', 'D', 'W', 'X'), MOUSE_DEFAULT_OFFSETX);
-        _shadow_offsety = _get_dat_int(_mouse, idx, DAT_ID('S', 'D', 'W', 'Y'), MOUSE_DEFAULT_OFFSETY);
-        _shadow_focus = _get_dat_int(_mouse, idx, DAT_ID('S', 'D', 'W', 'F'), MOUSE_DEFAULT_FOCUS);
-        default_shadow = _get_dat_int(_mouse, idx, DAT_ID('S', 'H', 'D', 'W'), FALSE);
-    }
-    for(i = 0; i < MOUSE_NUM_CURSORS; i++){
-        tmp = NULL;
-        if(_mouse){
-            for(ext = 0; _mouse_ext[ext]; ext++){
-                usprintf(buffer, "%s_%s", _cur_names[i], _mouse_ext[ext]);
-                idx = _get_dat_idx(_mouse, buffer);
-                if(idx > 0){
-                    tmp = (BITMAP*)_mouse[idx].dat;
-                    break;
-                }
-            }
-	    hotx = _get_dat_int(_mouse, idx, DAT_ID('H', 'O', 'T', 'X'), MOUSE_DEFAULT_FOCUSX);
-	    hoty = _get_dat_int(_mouse, idx, DAT_ID('H', 'O', 'T', 'Y'), MOUSE_DEFAULT_FOCUSY);
-            anim_type = _get_dat_int(_mouse, idx, DAT_ID('A', 'N', 'I', 'T'), AWE_MOUSE_LOOP_REPEAT);
-            speed = _get_dat_int(_mouse, idx, DAT_ID('S', 'P', 'E', 'D'), 0);
-            num_frames = _get_dat_int(_mouse, idx, DAT_ID('N', 'F', 'R', 'M'), 1);
-            cur_trans = _get_dat_int(_mouse, idx, DAT_ID('T', 'R', 'N', 'S'), default_trans);
-            shadowed = _get_dat_int(_mouse, idx, DAT_ID('S', 'H', 'D', 'W'), default_shadow);
-            shadow_method = _get_dat_int(_mouse, idx, DAT_ID('S', 'D', 'W', 'M'), FALSE);
-        }
-        if(tmp == NULL){
-            if(i < 14){
-                if((tmp = _create_mouse_sprite(_default_cursor[i].cursor)) == NULL){
-                    TRACE("Cursor: Load Failed\n");
-                    return 0;
-                }
-                TRACE("Cursor: Loading Default Cursor %s\n", _cur_names[i]);
-                hotx = _default_cursor[i].hotx;
-                hoty = _default_cursor[i].hoty;
-                anim_type = AWE_MOUSE_LOOP_REPEAT;
-                speed = 0;
-                num_frames = 1;
-                cur_trans = 0;
-                shadowed = _default_cursor[i].shadow;
-                shadow_method = FALSE;
-                _shadow_intensity = MOUSE_DEFAULT_INTENSITY;
-                _shadow_focus = MOUSE_DEFAULT_FOCUS;
-                _shadow_offsetx = MOUSE_DEFAULT_OFFSETX;
-                _shadow_offsety = MOUSE_DEFAULT_OFFSETY;
-            }
-            else{
-                // Return to top of loop
-                continue;
-            }
-        }    
-        _cursor[i] = _create_mouse_cursor(tmp, i, hotx, hoty, shadowed, shadow_method, num_frames, speed, anim_type, cur_trans);
-    }
+    dat = load_datafile(path);
     if(alpha)
         set_color_conversion(COLORCONV_TOTAL);
-    awe_set_mouse_cursor(awe_get_system_cursor(AWE_MOUSE_ARROW));
-    TRACE("Cursor: %s Loaded Successfully\n", !path ? "Default Cursor" : path);
-    return 1;
+    return dat;
+}
+
+
+// Initializes the cursors from a datafile read from a path, which is unloaded with them
+int awe_adopt_mouse_datafile(const char *path, DATAFILE *dat){
+    int ret = awe_load_datafile_mouse(dat);
+    if(path && dat)
+        _cursor_path = ustrdup(path);
+    TRACE("Cursor: %s Loaded\n", !path ? "Default Cursor" : path);
+    return ret;
 }
 
 
@@ -1027,11 +1300,12 @@ int awe_load_datafile_mouse(DATAFILE *dat){
             shadow_method = _get_dat_int(_mouse, idx, DAT_ID('S', 'D', 'W', 'M'), FALSE);
         }
         if(tmp == NULL){
-            if(i < 14){
-                if((tmp = _create_mouse_sprite(_default_cursor[i].cursor)) == NULL){
+            if(i < MOUSE_NUM_DEFAULT){
+                if(!_bake_default_sprites()){
                     TRACE("Cursor: Load Failed\n");
                     return 0;
                 }
+                tmp = _default_sprite[i];
                 TRACE("Cursor: Loading Default Cursor %s\n", _cur_names[i]);
                 hotx = _default_cursor[i].hotx;
                 hoty = _default_cursor[i].hoty;
@@ -1070,7 +1344,6 @@ int awe_install_mouse(void){
         #endif
         LOCK_FUNCTION(_timer);
         LOCK_VARIABLE(_mouse_timer);
-        install_int_ex(_timer, BPS_TO_TIMER(60));
 	_mouse_install_count++;
 	TRACE("Cursor: Initialization Successful\n");
 	return 1;
@@ -1086,7 +1359,10 @@ void awe_mouse_exit(void){
         AWE_DL_NODE *node;
         AWE_DL_NODE *next;
 	awe_show_mouse(NULL);
-        remove_int(_timer);
+        if(_mouse_timer_installed){
+            remove_int(_timer);
+            _mouse_timer_installed = FALSE;
+        }
         /* Destroy System Cursors */
         _destroy_mouse();
         /* Destroy User Cursors */
@@ -1095,6 +1371,7 @@ void awe_mouse_exit(void){
             _destroy_mouse_cursor((AWE_CURSOR*)((AWE_DL_DATA_NODE*)node)->data);
             node = next;
         }
+        _destroy_default_sprites();
 	TRACE("Cursor: Shutdown Successful\n");
     }
     _mouse_install_count--;
@@ -1110,27 +1387,17 @@ AWE_CURSOR *awe_get_system_cursor(AWE_CURSOR_TYPE type){
 AWE_CURSOR *awe_set_mouse_cursor(AWE_CURSOR *cursor){
     BITMAP *old_mouse_screen = _mouse_screen;
     AWE_CURSOR *old_cursor = _current_cur;
+    int direct;
     if(!mouse_driver)
         return NULL;
     if(!cursor)
         return _current_cur;
     if(_current_cur == cursor && _mouse_bg)
         return NULL;
-    if(_mouse_screen){
+    /* A cursor drawn onto the video screen is removed first; an overlaid cursor is just presented again */
+    direct = _mouse_screen && !_mouse_overlay();
+    if(direct)
         awe_show_mouse(NULL);
-        if(old_mouse_screen){
-            acquire_bitmap(old_mouse_screen);
-            if(_mouse_bg){
-                blit(old_mouse_screen, _mouse_vid_screen, _old_mx - _current_cur->hotx, _old_my - _current_cur->hoty, _old_mx - _current_cur->hotx, _old_my - _current_cur->hoty, _mouse_bg->w, _mouse_bg->h);
-                blit(old_mouse_screen, _mouse_vid_screen, _mx - _current_cur->hotx, _my - _current_cur->hoty, _mx - _current_cur->hotx, _my - _current_cur->hoty, _mouse_bg->w, _mouse_bg->h);
-            }    
-            if(_current_cur->shadow){
-                blit(old_mouse_screen, _mouse_vid_screen, _old_mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _old_my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _old_mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _old_my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _shadow_bg->w, _shadow_bg->h);
-                blit(old_mouse_screen, _mouse_vid_screen, _mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _shadow_bg->w, _shadow_bg->h);
-            }
-            release_bitmap(old_mouse_screen);
-        }
-    }
     _animation_dir = 1;
     _current_cur = cursor;
     _current_cur->cur_frame = 0;
@@ -1143,19 +1410,11 @@ AWE_CURSOR *awe_set_mouse_cursor(AWE_CURSOR *cursor){
             destroy_bitmap(_shadow_bg);
         _shadow_bg = create_bitmap(_current_cur->shadow[0]->w, _current_cur->shadow[0]->h);
     }    
-    if(old_mouse_screen){
+    _update_mouse_timer();
+    if(direct)
         awe_show_mouse(old_mouse_screen);
-        acquire_bitmap(old_mouse_screen);
-        if(_mouse_bg){
-            blit(old_mouse_screen, _mouse_vid_screen, _old_mx - _current_cur->hotx, _old_my - _current_cur->hoty, _old_mx - _current_cur->hotx, _old_my - _current_cur->hoty, _mouse_bg->w, _mouse_bg->h);
-            blit(old_mouse_screen, _mouse_vid_screen, _mx - _current_cur->hotx, _my - _current_cur->hoty, _mx - _current_cur->hotx, _my - _current_cur->hoty, _mouse_bg->w, _mouse_bg->h);
-        }    
-        if(_current_cur->shadow){
-            blit(old_mouse_screen, _mouse_vid_screen, _old_mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _old_my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _old_mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _old_my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _shadow_bg->w, _shadow_bg->h);
-            blit(old_mouse_screen, _mouse_vid_screen, _mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _shadow_bg->w, _shadow_bg->h);
-        }
-        release_bitmap(old_mouse_screen);
-    }
+    else
+        _update_overlay();
     return old_cursor;
 }
 
@@ -1176,13 +1435,14 @@ void awe_show_mouse(BITMAP *bmp){
     /* Set up default cursor */
     if (!_cursor[AWE_MOUSE_ARROW])
         awe_load_mouse(NULL);
-    if (_mouse_screen) {
+    if (_mouse_screen && !_mouse_overlay()) {
         acquire_bitmap(_mouse_screen);
         _draw_mouse(TRUE, FALSE);
         release_bitmap(_mouse_screen);
     }
     _mouse_screen = bmp;
-    if (bmp) {
+    _update_overlay();
+    if (bmp && !_mouse_overlay()) {
         acquire_bitmap(_mouse_screen);
         _draw_mouse(FALSE, TRUE);
         release_bitmap(_mouse_screen);
@@ -1194,13 +1454,25 @@ void awe_show_mouse(BITMAP *bmp){
 void awe_redraw_mouse(){
     if(!_mouse_screen)
         return;
-    _draw_mouse(TRUE, TRUE);
-    blit(_mouse_screen, _mouse_vid_screen, _old_mx - _current_cur->hotx, _old_my - _current_cur->hoty, _old_mx - _current_cur->hotx, _old_my - _current_cur->hoty, _mouse_bg->w, _mouse_bg->h);
-    blit(_mouse_screen, _mouse_vid_screen, _mx - _current_cur->hotx, _my - _current_cur->hoty, _mx - _current_cur->hotx, _my - _current_cur->hoty, _mouse_bg->w, _mouse_bg->h);
-    if(_current_cur->shadow && _show_shadow){
-        blit(_mouse_screen, _mouse_vid_screen, _old_mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _old_my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _old_mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _old_my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _shadow_bg->w, _shadow_bg->h);
-        blit(_mouse_screen, _mouse_vid_screen, _mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _shadow_bg->w, _shadow_bg->h);
+    if(_mouse_overlay()){
+        _update_overlay();
+        return;
     }
+    acquire_bitmap(_mouse_screen);
+    _draw_mouse(TRUE, TRUE);
+    release_bitmap(_mouse_screen);
+}
+
+
+// Presents an area of a bitmap to the video screen with the cursor on top
+void awe_present_mouse_area(BITMAP *bmp, int x, int y, int w, int h){
+    if(!bmp)
+        return;
+    if(!_mouse_vid_screen)
+        _mouse_vid_screen = screen;
+    acquire_bitmap(_mouse_vid_screen);
+    _present_area(bmp, x, y, w, h);
+    release_bitmap(_mouse_vid_screen);
 }
 
 
@@ -1280,19 +1552,16 @@ void awe_unscare_mouse(void){
 // Toggles shadows on or off and is also used to adjust shadow properties while it is hidden
 void awe_show_mouse_shadow(AWE_CURSOR_SHADOW shadow){
     int tmp = shadow ? TRUE : FALSE;
+    int direct = _mouse_screen && !_mouse_overlay();
     if(_show_shadow == tmp)
         return;
-    awe_scare_mouse();
+    if(direct)
+        awe_scare_mouse();
     _show_shadow = tmp;
-    awe_unscare_mouse();
-    if (_mouse_screen){
-        acquire_bitmap(_mouse_screen);
-        if(_current_cur->shadow){
-            blit(_mouse_screen, _mouse_vid_screen, _old_mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _old_my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _old_mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _old_my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _shadow_bg->w, _shadow_bg->h);
-            blit(_mouse_screen, _mouse_vid_screen, _mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _mx - _current_cur->hotx + _shadow_offsetx - _shadow_focus, _my - _current_cur->hoty + _shadow_offsety - _shadow_focus, _shadow_bg->w, _shadow_bg->h);
-        }
-        release_bitmap(_mouse_screen);
-    }
+    if(direct)
+        awe_unscare_mouse();
+    else
+        _update_overlay();
 }
 
 
@@ -1347,18 +1616,7 @@ void awe_scare_mouse_area(int x, int y, int w, int h){
 
 // Returns the portion of the screen the mouse occupies
 void awe_get_mouse_area(int *x, int *y, int *w, int *h){
-    if(_current_cur->shadow && _show_shadow){
-        *x = MIN(_mx - _current_cur->hotx, _mx + _shadow_offsetx - _shadow_focus - _current_cur->hotx);
-        *y = MIN(_my - _current_cur->hoty, _my + _shadow_offsety - _shadow_focus - _current_cur->hoty);
-        *w = _mouse_bg->w + abs(_shadow_offsetx) + _shadow_focus;
-        *h = _mouse_bg->h + abs(_shadow_offsety) + _shadow_focus;
-    }
-    else{
-        *x = _mx - _current_cur->hotx;
-        *y = _my - _current_cur->hoty;
-        *w = _mouse_bg->w;
-        *h = _mouse_bg->h;
-    }
+    _get_cursor_area(_mx, _my, x, y, w, h);
 }
 
 
@@ -47,6 +47,8 @@ static void _push_button_constructor(AWE_OBJECT *obj)
     AWE_PUSH_BUTTON *tmp = (AWE_PUSH_BUTTON *)obj;
     tmp->text = ustrdup(empty_string);
     tmp->font = font;
+    tmp->text_width = 0;
+    tmp->text_height = text_height(font);
     tmp->border = PUSH_BUTTON_DEFAULT_BORDER;
     memcpy(&tmp->margin, &_margin, sizeof(_margin));
     for(i = 0; i < AWE_PUSH_BUTTON_NUM_TEXTURES; i++){
@@ -79,6 +81,7 @@ static void _push_button_constructor(AWE_OBJECT *obj)
             memcpy(&tmp->texture[i].font_sdw, &_shadow_color_normal, sizeof(RGB));
         }      
     }
+    tmp->color_version = 0;
 }
 
 
@@ -96,12 +99,38 @@ static void _push_button_get_text(AWE_OBJECT *obj, void *data)
 }
 
 
+//returns the hot key of a text; it is the character after the '&'
+static int _get_hot_key(const char *text)
+{
+    int fmt = get_uformat();
+    const char *t;
+
+    //'&' is never part of a multibyte character in these formats
+    t = fmt == U_ASCII || fmt == U_UTF8 ? strchr(text, '&') : ustrchr(text, '&');
+
+    if (!t) return 0;
+    t += ucwidth('&');
+    return utolower(ugetc(t));
+}
+
+
+//measures the text; the size is kept until the text or the font changes
+static void _push_button_measure_text(AWE_PUSH_BUTTON *btn)
+{
+    btn->text_width = text_length(btn->font, btn->text);
+    btn->text_height = text_height(btn->font);
+}
+
+
 //sets the text
 static void _push_button_set_text(AWE_OBJECT *obj, void *data)
 {
     const char *new_text = *(const char **)data;
     free(((AWE_PUSH_BUTTON *)obj)->text);
     ((AWE_PUSH_BUTTON *)obj)->text = ustrdup(new_text ? new_text : empty_string);
+    ((AWE_PUSH_BUTTON *)obj)->hot_key = _get_hot_key(((AWE_PUSH_BUTTON *)obj)->text);
+    _push_button_measure_text((AWE_PUSH_BUTTON *)obj);
+    awe_control_hot_key_changed((AWE_WIDGET *)obj);
     awe_set_widget_dirty((AWE_WIDGET*)obj);
 }
 
@@ -117,6 +146,7 @@ static void _push_button_get_font(AWE_OBJECT *obj, void *data)
 static void _push_button_set_font(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->font = *(FONT **)data;
+    _push_button_measure_text((AWE_PUSH_BUTTON *)obj);
     awe_set_widget_dirty((AWE_WIDGET *)obj);
 }
 
@@ -226,6 +256,14 @@ static void _push_button_set_border(AWE_OBJECT *obj, void *data)
 }
 
 
+//invalidates the pixel values of the colors
+static void _push_button_colors_changed(AWE_OBJECT *obj)
+{
+    ((AWE_PUSH_BUTTON *)obj)->color_version = 0;
+    awe_set_widget_dirty((AWE_WIDGET *)obj);
+}
+
+
 //gets the top left enabled face color
 static void _push_button_get_face_color_top_left_enabled(AWE_OBJECT *obj, void *data)
 {
@@ -237,7 +275,7 @@ static void _push_button_get_face_color_top_left_enabled(AWE_OBJECT *obj, void *
 static void _push_button_set_face_color_top_left_enabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_ENABLED].face_col[AWE_PUSH_BUTTON_FACE_TOP_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -252,7 +290,7 @@ static void _push_button_get_face_color_top_right_enabled(AWE_OBJECT *obj, void
 static void _push_button_set_face_color_top_right_enabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_ENABLED].face_col[AWE_PUSH_BUTTON_FACE_TOP_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -267,7 +305,7 @@ static void _push_button_get_face_color_bottom_left_enabled(AWE_OBJECT *obj, voi
 static void _push_button_set_face_color_bottom_left_enabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_ENABLED].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -282,7 +320,7 @@ static void _push_button_get_face_color_bottom_right_enabled(AWE_OBJECT *obj, vo
 static void _push_button_set_face_color_bottom_right_enabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_ENABLED].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -297,7 +335,7 @@ static void _push_button_get_face_color_top_left_disabled(AWE_OBJECT *obj, void
 static void _push_button_set_face_color_top_left_disabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_DISABLED].face_col[AWE_PUSH_BUTTON_FACE_TOP_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -312,7 +350,7 @@ static void _push_button_get_face_color_top_right_disabled(AWE_OBJECT *obj, void
 static void _push_button_set_face_color_top_right_disabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_DISABLED].face_col[AWE_PUSH_BUTTON_FACE_TOP_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -327,7 +365,7 @@ static void _push_button_get_face_color_bottom_left_disabled(AWE_OBJECT *obj, vo
 static void _push_button_set_face_color_bottom_left_disabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_DISABLED].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -342,7 +380,7 @@ static void _push_button_get_face_color_bottom_right_disabled(AWE_OBJECT *obj, v
 static void _push_button_set_face_color_bottom_right_disabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_DISABLED].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -357,7 +395,7 @@ static void _push_button_get_face_color_top_left_pressed(AWE_OBJECT *obj, void *
 static void _push_button_set_face_color_top_left_pressed(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_PRESSED].face_col[AWE_PUSH_BUTTON_FACE_TOP_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -372,7 +410,7 @@ static void _push_button_get_face_color_top_right_pressed(AWE_OBJECT *obj, void
 static void _push_button_set_face_color_top_right_pressed(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_PRESSED].face_col[AWE_PUSH_BUTTON_FACE_TOP_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -387,7 +425,7 @@ static void _push_button_get_face_color_bottom_left_pressed(AWE_OBJECT *obj, voi
 static void _push_button_set_face_color_bottom_left_pressed(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_PRESSED].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -402,7 +440,7 @@ static void _push_button_get_face_color_bottom_right_pressed(AWE_OBJECT *obj, vo
 static void _push_button_set_face_color_bottom_right_pressed(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_PRESSED].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -417,7 +455,7 @@ static void _push_button_get_face_color_top_left_highlighted(AWE_OBJECT *obj, vo
 static void _push_button_set_face_color_top_left_highlighted(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_HIGHLIGHTED].face_col[AWE_PUSH_BUTTON_FACE_TOP_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -432,7 +470,7 @@ static void _push_button_get_face_color_top_right_highlighted(AWE_OBJECT *obj, v
 static void _push_button_set_face_color_top_right_highlighted(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_HIGHLIGHTED].face_col[AWE_PUSH_BUTTON_FACE_TOP_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -447,7 +485,7 @@ static void _push_button_get_face_color_bottom_left_highlighted(AWE_OBJECT *obj,
 static void _push_button_set_face_color_bottom_left_highlighted(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_HIGHLIGHTED].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -462,7 +500,7 @@ static void _push_button_get_face_color_bottom_right_highlighted(AWE_OBJECT *obj
 static void _push_button_set_face_color_bottom_right_highlighted(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_HIGHLIGHTED].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -477,7 +515,7 @@ static void _push_button_get_face_color_top_left_focused(AWE_OBJECT *obj, void *
 static void _push_button_set_face_color_top_left_focused(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_FOCUSED].face_col[AWE_PUSH_BUTTON_FACE_TOP_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -492,7 +530,7 @@ static void _push_button_get_face_color_top_right_focused(AWE_OBJECT *obj, void
 static void _push_button_set_face_color_top_right_focused(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_FOCUSED].face_col[AWE_PUSH_BUTTON_FACE_TOP_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -507,7 +545,7 @@ static void _push_button_get_face_color_bottom_left_focused(AWE_OBJECT *obj, voi
 static void _push_button_set_face_color_bottom_left_focused(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_FOCUSED].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -522,7 +560,7 @@ static void _push_button_get_face_color_bottom_right_focused(AWE_OBJECT *obj, vo
 static void _push_button_set_face_color_bottom_right_focused(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_FOCUSED].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -537,7 +575,7 @@ static void _push_button_get_edge_color_top_left_enabled(AWE_OBJECT *obj, void *
 static void _push_button_set_edge_color_top_left_enabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_ENABLED].edge_col[AWE_PUSH_BUTTON_EDGE_TOP_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -552,7 +590,7 @@ static void _push_button_get_edge_color_bottom_right_enabled(AWE_OBJECT *obj, vo
 static void _push_button_set_edge_color_bottom_right_enabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_ENABLED].edge_col[AWE_PUSH_BUTTON_EDGE_BOTTOM_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -567,7 +605,7 @@ static void _push_button_get_edge_color_top_left_disabled(AWE_OBJECT *obj, void
 static void _push_button_set_edge_color_top_left_disabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_DISABLED].edge_col[AWE_PUSH_BUTTON_EDGE_TOP_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -582,7 +620,7 @@ static void _push_button_get_edge_color_bottom_right_disabled(AWE_OBJECT *obj, v
 static void _push_button_set_edge_color_bottom_right_disabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_DISABLED].edge_col[AWE_PUSH_BUTTON_EDGE_BOTTOM_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -597,7 +635,7 @@ static void _push_button_get_edge_color_top_left_pressed(AWE_OBJECT *obj, void *
 static void _push_button_set_edge_color_top_left_pressed(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_PRESSED].edge_col[AWE_PUSH_BUTTON_EDGE_TOP_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -612,7 +650,7 @@ static void _push_button_get_edge_color_bottom_right_pressed(AWE_OBJECT *obj, vo
 static void _push_button_set_edge_color_bottom_right_pressed(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_PRESSED].edge_col[AWE_PUSH_BUTTON_EDGE_BOTTOM_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -627,7 +665,7 @@ static void _push_button_get_edge_color_top_left_highlighted(AWE_OBJECT *obj, vo
 static void _push_button_set_edge_color_top_left_highlighted(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_HIGHLIGHTED].edge_col[AWE_PUSH_BUTTON_EDGE_TOP_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -642,7 +680,7 @@ static void _push_button_get_edge_color_bottom_right_highlighted(AWE_OBJECT *obj
 static void _push_button_set_edge_color_bottom_right_highlighted(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_HIGHLIGHTED].edge_col[AWE_PUSH_BUTTON_EDGE_BOTTOM_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -657,7 +695,7 @@ static void _push_button_get_edge_color_top_left_focused(AWE_OBJECT *obj, void *
 static void _push_button_set_edge_color_top_left_focused(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_FOCUSED].edge_col[AWE_PUSH_BUTTON_EDGE_TOP_LEFT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -672,7 +710,7 @@ static void _push_button_get_edge_color_bottom_right_focused(AWE_OBJECT *obj, vo
 static void _push_button_set_edge_color_bottom_right_focused(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_FOCUSED].edge_col[AWE_PUSH_BUTTON_EDGE_BOTTOM_RIGHT] = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -687,7 +725,7 @@ static void _push_button_get_font_color_enabled(AWE_OBJECT *obj, void *data)
 static void _push_button_set_font_color_enabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_ENABLED].font_col = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -702,7 +740,7 @@ static void _push_button_get_font_color_disabled(AWE_OBJECT *obj, void *data)
 static void _push_button_set_font_color_disabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_DISABLED].font_col = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -717,7 +755,7 @@ static void _push_button_get_font_color_pressed(AWE_OBJECT *obj, void *data)
 static void _push_button_set_font_color_pressed(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_PRESSED].font_col = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -732,7 +770,7 @@ static void _push_button_get_font_color_highlighted(AWE_OBJECT *obj, void *data)
 static void _push_button_set_font_color_highlighted(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_HIGHLIGHTED].font_col = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -747,7 +785,7 @@ static void _push_button_get_font_color_focused(AWE_OBJECT *obj, void *data)
 static void _push_button_set_font_color_focused(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_FOCUSED].font_col = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -762,7 +800,7 @@ static void _push_button_get_font_shadow_enabled(AWE_OBJECT *obj, void *data)
 static void _push_button_set_font_shadow_enabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_ENABLED].font_sdw = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -777,7 +815,7 @@ static void _push_button_get_font_shadow_disabled(AWE_OBJECT *obj, void *data)
 static void _push_button_set_font_shadow_disabled(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_DISABLED].font_sdw = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -792,7 +830,7 @@ static void _push_button_get_font_shadow_pressed(AWE_OBJECT *obj, void *data)
 static void _push_button_set_font_shadow_pressed(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_PRESSED].font_sdw = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -807,7 +845,7 @@ static void _push_button_get_font_shadow_highlighted(AWE_OBJECT *obj, void *data
 static void _push_button_set_font_shadow_highlighted(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_HIGHLIGHTED].font_sdw = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -822,7 +860,7 @@ static void _push_button_get_font_shadow_focused(AWE_OBJECT *obj, void *data)
 static void _push_button_set_font_shadow_focused(AWE_OBJECT *obj, void *data)
 {
     ((AWE_PUSH_BUTTON *)obj)->texture[AWE_PUSH_BUTTON_TEXTURE_FOCUSED].font_sdw = *(RGB *)data;
-    awe_set_widget_dirty((AWE_WIDGET *)obj);
+    _push_button_colors_changed(obj);
 }
 
 
@@ -952,11 +990,11 @@ static AWE_CLASS_PROPERTY _push_button_properties[] = {
     { AWE_ID_SHADOW_COLOR_PRESSED, "RGB", sizeof(RGB), _push_button_get_font_shadow_pressed, _push_button_set_font_shadow_pressed, 0 },
     { AWE_ID_SHADOW_COLOR_HIGHLIGHTED, "RGB", sizeof(RGB), _push_button_get_font_shadow_highlighted, _push_button_set_font_shadow_highlighted, 0 },
     { AWE_ID_SHADOW_COLOR_FOCUSED, "RGB", sizeof(RGB), _push_button_get_font_shadow_focused, _push_button_set_font_shadow_focused, 0 }, 
-    { AWE_ID_TEXTURE_ENABLED, "AWE TEXTURE *", sizeof(AWE_TEXTURE *), _push_button_get_texture_enabled, _push_button_set_texture_enabled, 0 },
-    { AWE_ID_TEXTURE_DISABLED, "AWE TEXTURE *", sizeof(AWE_TEXTURE *), _push_button_get_texture_disabled, _push_button_set_texture_disabled, 0 },
-    { AWE_ID_TEXTURE_PRESSED, "AWE TEXTURE *", sizeof(AWE_TEXTURE *), _push_button_get_texture_pressed, _push_button_set_texture_pressed, 0 },
-    { AWE_ID_TEXTURE_HIGHLIGHTED, "AWE TEXTURE *", sizeof(AWE_TEXTURE *), _push_button_get_texture_highlighted, _push_button_set_texture_highlighted, 0 },
-    { AWE_ID_TEXTURE_FOCUSED, "AWE TEXTURE *", sizeof(AWE_TEXTURE *), _push_button_get_texture_focused, _push_button_set_texture_focused, 0 },
+    { AWE_ID_TEXTURE_ENABLED, AWE_TEXTURE_PROPERTY, sizeof(AWE_TEXTURE *), _push_button_get_texture_enabled, _push_button_set_texture_enabled, 0 },
+    { AWE_ID_TEXTURE_DISABLED, AWE_TEXTURE_PROPERTY, sizeof(AWE_TEXTURE *), _push_button_get_texture_disabled, _push_button_set_texture_disabled, 0 },
+    { AWE_ID_TEXTURE_PRESSED, AWE_TEXTURE_PROPERTY, sizeof(AWE_TEXTURE *), _push_button_get_texture_pressed, _push_button_set_texture_pressed, 0 },
+    { AWE_ID_TEXTURE_HIGHLIGHTED, AWE_TEXTURE_PROPERTY, sizeof(AWE_TEXTURE *), _push_button_get_texture_highlighted, _push_button_set_texture_highlighted, 0 },
+    { AWE_ID_TEXTURE_FOCUSED, AWE_TEXTURE_PROPERTY, sizeof(AWE_TEXTURE *), _push_button_get_texture_focused, _push_button_set_texture_focused, 0 },
     { 0 }
 };
 
@@ -1000,7 +1038,8 @@ AWE_PUSH_BUTTON_VTABLE awe_push_button_vtable = {
     ,
     //control
     {
-        awe_push_button_key_press
+        awe_push_button_key_press,
+        awe_push_button_get_hot_key
     }
     ,
     //geometry
@@ -1105,12 +1144,30 @@ AWE_OBJECT *awe_push_button_clone(AWE_OBJECT *wgt)
 }
 
 
+//makes the pixel values of the colors
+int awe_push_button_make_colors(AWE_PUSH_BUTTON *btn)
+{
+    AWE_PUSH_BUTTON_STATE *t;
+    int i;
+
+    if (btn->color_version == awe_get_color_version()) return 0;
+    for(t = btn->texture; t < btn->texture + AWE_PUSH_BUTTON_NUM_TEXTURES; t++) {
+        for(i = 0; i < AWE_PUSH_BUTTON_NUM_FACES; i++) t->face_pix[i] = AWE_MAKE_COLOR(t->face_col[i]);
+        for(i = 0; i < AWE_PUSH_BUTTON_NUM_EDGES; i++) t->edge_pix[i] = AWE_MAKE_COLOR(t->edge_col[i]);
+        t->font_pix = AWE_MAKE_COLOR(t->font_col);
+        t->sdw_pix = awe_make_shadow_color(t->font_sdw);
+    }
+    btn->color_version = awe_get_color_version();
+    return 1;
+}
+
+
 //push_button paint
 void awe_push_button_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *clip)
 {
     AWE_PUSH_BUTTON *btn = (AWE_PUSH_BUTTON *)wgt;
-    int tx = (wgt->width - text_length(btn->font, btn->text)) >> 1;
-    int ty = (wgt->height - text_height(btn->font)) >> 1;
+    int tx = (wgt->width - btn->text_width) >> 1;
+    int ty = (wgt->height - btn->text_height) >> 1;
     int state;
 
     solid_mode();
@@ -1127,19 +1184,21 @@ void awe_push_button_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *
         state = AWE_PUSH_BUTTON_TEXTURE_ENABLED;
     
 
+    awe_push_button_make_colors(btn);
+
     if(btn->texture[state].texture){
          awe_draw_texture_hor_s(canvas, btn->texture[state].texture, 0, 0, wgt->width, wgt->height);
     }
     else{
         awe_fill_gradient_s(canvas, btn->border, btn->border, wgt->width - (btn->border * 2), wgt->height - (btn->border * 2), 
-            AWE_MAKE_COLOR(btn->texture[state].face_col[AWE_PUSH_BUTTON_FACE_TOP_LEFT]),
-            AWE_MAKE_COLOR(btn->texture[state].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_LEFT]),
-            AWE_MAKE_COLOR(btn->texture[state].face_col[AWE_PUSH_BUTTON_FACE_BOTTOM_RIGHT]),
-            AWE_MAKE_COLOR(btn->texture[state].face_col[AWE_PUSH_BUTTON_FACE_TOP_RIGHT]));
+            btn->texture[state].face_pix[AWE_PUSH_BUTTON_FACE_TOP_LEFT],
+            btn->texture[state].face_pix[AWE_PUSH_BUTTON_FACE_BOTTOM_LEFT],
+            btn->texture[state].face_pix[AWE_PUSH_BUTTON_FACE_BOTTOM_RIGHT],
+            btn->texture[state].face_pix[AWE_PUSH_BUTTON_FACE_TOP_RIGHT]);
 
         awe_draw_3d_rect_s(canvas, 0, 0, wgt->width, wgt->height, 
-            AWE_MAKE_COLOR(btn->texture[state].edge_col[AWE_PUSH_BUTTON_EDGE_TOP_LEFT]),
-            AWE_MAKE_COLOR(btn->texture[state].edge_col[AWE_PUSH_BUTTON_EDGE_BOTTOM_RIGHT]), 
+            btn->texture[state].edge_pix[AWE_PUSH_BUTTON_EDGE_TOP_LEFT],
+            btn->texture[state].edge_pix[AWE_PUSH_BUTTON_EDGE_BOTTOM_RIGHT], 
             btn->border);
     }
 
@@ -1148,13 +1207,13 @@ void awe_push_button_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *
         ty += 1;
     }
 
-    if(AWE_MAKE_COLOR(btn->texture[state].font_sdw) != makecol(255, 0, 255))
-        awe_draw_gui_text(canvas, btn->font, btn->text, tx + 1, ty + 1, AWE_MAKE_COLOR(btn->texture[state].font_sdw), -1);
+    if(btn->texture[state].sdw_pix != -1)
+        awe_draw_gui_text(canvas, btn->font, btn->text, tx + 1, ty + 1, btn->texture[state].sdw_pix, -1);
     
-    awe_draw_gui_text(canvas, btn->font, btn->text, tx, ty, AWE_MAKE_COLOR(btn->texture[state].font_col), -1);
+    awe_draw_gui_text(canvas, btn->font, btn->text, tx, ty, btn->texture[state].font_pix, -1);
 
     if (awe_get_focus_widget() == wgt && state != AWE_PUSH_BUTTON_TEXTURE_DISABLED)
-        awe_draw_rect_pattern_s(canvas, btn->border + 1, btn->border + 1, wgt->width - (btn->border * 2) - 2, wgt->height - (btn->border * 2) - 2, AWE_MAKE_COLOR(btn->texture[state].font_col), AWE_PATTERN_DOT_DOT);
+        awe_draw_rect_pattern_s(canvas, btn->border + 1, btn->border + 1, wgt->width - (btn->border * 2) - 2, wgt->height - (btn->border * 2) - 2, btn->texture[state].font_pix, AWE_PATTERN_DOT_DOT);
 }
 
 
@@ -1205,16 +1264,20 @@ void awe_push_button_mouse_leave(AWE_WIDGET *wgt, const AWE_EVENT *event)
 
 int awe_push_button_key_press(AWE_WIDGET *wgt, const AWE_EVENT *event)
 {
-    const char *t = ustrchr(((AWE_PUSH_BUTTON *)wgt)->text, '&');
+    int hot_key = ((AWE_PUSH_BUTTON *)wgt)->hot_key;
 
-    if (!t) return 0;
-    t += ucwidth('&');
-    if (utolower(ugetc(t)) != utolower(event->key.key)) return 0;
+    if (!hot_key || hot_key != utolower(event->key.key)) return 0;
     if (!awe_set_focus_widget(wgt)) return 0;
     return 1;
 }
 
 
+int awe_push_button_get_hot_key(AWE_WIDGET *wgt)
+{
+    return ((AWE_PUSH_BUTTON *)wgt)->hot_key;
+}
+
+
 void awe_push_button_timer(AWE_WIDGET *wgt, const AWE_EVENT *event)
 {
     awe_do_widget_event0(wgt, AWE_ID_PUSH_BUTTON_HELD_DOWN);
@@ -1226,9 +1289,8 @@ void awe_push_button_set_geometry(AWE_WIDGET *wgt)
     AWE_PUSH_BUTTON *btn = (AWE_PUSH_BUTTON *)wgt;
     awe_override_widget_size(
         wgt, 
-        text_length(btn->font,
-        btn->text) + btn->margin.left + btn->margin.right, 
-        text_height(btn->font) + btn->margin.top + btn->margin.bottom
+        btn->text_width + btn->margin.left + btn->margin.right, 
+        btn->text_height + btn->margin.top + btn->margin.bottom
     );
 }
 
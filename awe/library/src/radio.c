@@ -88,7 +88,8 @@ AWE_RADIO_VTABLE awe_radio_vtable = {
     ,
     //control
     {
-        awe_push_button_key_press
+        awe_push_button_key_press,
+        awe_push_button_get_hot_key
     }
     ,
     //geometry
@@ -151,11 +152,12 @@ void awe_radio_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *clip)
 {
     AWE_PUSH_BUTTON *btn = (AWE_PUSH_BUTTON *)wgt;
     int state = 0;
-    int tx = ((AWE_CHECKBOX *)wgt)->text_dir ? wgt->height + 5 : wgt->width - wgt->height - text_length(btn->font, btn->text) - 5;
-    int ty = (wgt->height - text_height(btn->font)) >> 1;
+    int tx = ((AWE_CHECKBOX *)wgt)->text_dir ? wgt->height + 5 : wgt->width - wgt->height - btn->text_width - 5;
+    int ty = (wgt->height - btn->text_height) >> 1;
     int cx = ((AWE_CHECKBOX *)wgt)->text_dir ? 0 : wgt->width - wgt->height;
 
     solid_mode();
+    awe_checkbox_make_colors((AWE_CHECKBOX *)wgt);
     
     if(!awe_is_enabled_widget_tree(wgt))
         state = AWE_PUSH_BUTTON_TEXTURE_DISABLED;
@@ -166,27 +168,27 @@ void awe_radio_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *clip)
     else
         state = AWE_PUSH_BUTTON_TEXTURE_ENABLED;
 
-    awe_fill_circle(canvas, cx + (wgt->height >> 1), wgt->height >> 1, (wgt->height >> 1) - 1, AWE_MAKE_COLOR(btn->texture[state].face_col[AWE_PUSH_BUTTON_FACE_TOP_LEFT]));
+    awe_fill_circle(canvas, cx + (wgt->height >> 1), wgt->height >> 1, (wgt->height >> 1) - 1, btn->texture[state].face_pix[AWE_PUSH_BUTTON_FACE_TOP_LEFT]);
 
     awe_draw_3d_circle(canvas, cx + (wgt->height >> 1), wgt->height >> 1, wgt->height >> 1,
-        AWE_MAKE_COLOR(btn->texture[state].edge_col[AWE_PUSH_BUTTON_EDGE_TOP_LEFT]),
-        AWE_MAKE_COLOR(btn->texture[state].edge_col[AWE_PUSH_BUTTON_EDGE_BOTTOM_RIGHT]), 
+        btn->texture[state].edge_pix[AWE_PUSH_BUTTON_EDGE_TOP_LEFT],
+        btn->texture[state].edge_pix[AWE_PUSH_BUTTON_EDGE_BOTTOM_RIGHT], 
         1);
     
     awe_fill_rect_s(canvas, ((AWE_CHECKBOX *)wgt)->text_dir ? wgt->height + 3 : 0,
-        0, wgt->width - wgt->height - 3, wgt->height, AWE_MAKE_COLOR(((AWE_CHECKBOX *)wgt)->bg));
+        0, wgt->width - wgt->height - 3, wgt->height, ((AWE_CHECKBOX *)wgt)->bg_pix);
 
-    if(AWE_MAKE_COLOR(btn->texture[state].font_sdw) != makecol(255, 0, 255))
-        awe_draw_gui_text(canvas, btn->font, btn->text, tx + 1, ty + 1, AWE_MAKE_COLOR(btn->texture[state].font_sdw), -1);
+    if(btn->texture[state].sdw_pix != -1)
+        awe_draw_gui_text(canvas, btn->font, btn->text, tx + 1, ty + 1, btn->texture[state].sdw_pix, -1);
     
-    awe_draw_gui_text(canvas, btn->font, btn->text, tx, ty, AWE_MAKE_COLOR(btn->texture[state].font_col), -1);
+    awe_draw_gui_text(canvas, btn->font, btn->text, tx, ty, btn->texture[state].font_pix, -1);
 
     if(((AWE_TOGGLE_BUTTON *)wgt)->toggle)
-        awe_fill_circle(canvas, cx + (wgt->height >> 1), wgt->height >> 1, (wgt->height >> 1) - 4, AWE_MAKE_COLOR(btn->texture[state].font_col));
+        awe_fill_circle(canvas, cx + (wgt->height >> 1), wgt->height >> 1, (wgt->height >> 1) - 4, btn->texture[state].font_pix);
 
     if (awe_get_focus_widget() == wgt && state != AWE_PUSH_BUTTON_TEXTURE_DISABLED)
         awe_draw_rect_pattern_s(canvas, ((AWE_CHECKBOX *)wgt)->text_dir ? wgt->height + 3 : 0,
-            0, wgt->width - wgt->height - 3, wgt->height, AWE_MAKE_COLOR(btn->texture[state].font_col), AWE_PATTERN_DOT_DOT);
+            0, wgt->width - wgt->height - 3, wgt->height, btn->texture[state].font_pix, AWE_PATTERN_DOT_DOT);
 }
 
 
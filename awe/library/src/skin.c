@@ -9,6 +9,30 @@
 #define LITTLE_ENDIAN   1
 
 
+/* maximum width and height of an atlas bitmap; bigger bitmaps are left
+   where the datafile loaded them
+ */
+#define SKIN_ATLAS_SIZE 1024
+
+
+/* compiled skin format; numbers are 32 bit little endian and offsets are
+   from the start of the file. the header points to the tables of pages,
+   entries and datafile objects, which are followed by the names, data and
+   pixels, each aligned to 4 bytes. entries are sorted by name, and pixels
+   are in the byte order of the machine that compiled the skin.
+ */
+#define SKIN_COMPILED_MAGIC         DAT_ID('A', 'W', 'S', 'K')
+#define SKIN_COMPILED_VERSION       1
+#define SKIN_COMPILED_ALPHA         1
+#define SKIN_COMPILED_BIG_ENDIAN    2
+
+
+/* zero bytes after a loaded compiled skin image; enough for the widest
+   character, so as that strings can be checked without reading past it
+ */
+#define SKIN_IMAGE_PADDING          8
+
+
 /** skin tile methods
  */
 enum _SKIN_TILE_METHOD {
@@ -31,6 +55,15 @@ enum _SKIN_OBJECT_TYPE {
 typedef enum _SKIN_OBJECT_TYPE _SKIN_OBJECT_TYPE;
 
 
+struct _BOARDER {
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+typedef struct _BOARDER _BOARDER;
+
+
 /** skin object
  */
 struct _SKIN_OBJECT {
@@ -44,17 +77,188 @@ struct _SKIN_OBJECT {
     void *data;
     /* Data Destroy Callback */
     void (*destroy_object)(void *data);
+    /* Object Whose Data Is Linked */
+    struct _SKIN_OBJECT *link;
+    /* Source Area And Boarder Of Bitmaps And Textures */
+    BITMAP *src;
+    int x;
+    int y;
+    int w;
+    int h;
+    _BOARDER boarder;
+    /* Font Data And Size */
+    const char *font_data;
+    long font_data_len;
+    int font_size;
+    /* Non-Zero Once The Data Is Created */
+    int loaded;
+    /* Hash Of The Name */
+    unsigned hash;
 };
 typedef struct _SKIN_OBJECT _SKIN_OBJECT;
 
 
-struct _BOARDER {
-    int left;
-    int top;
-    int right;
-    int bottom;
+/** compiled skin header fields
+ */
+enum _SKIN_HEADER_FIELD {
+    SKIN_HEADER_MAGIC,
+    SKIN_HEADER_VERSION,
+    SKIN_HEADER_FLAGS,
+    SKIN_HEADER_PAGES,
+    SKIN_HEADER_PAGE_TABLE,
+    SKIN_HEADER_ENTRIES,
+    SKIN_HEADER_ENTRY_TABLE,
+    SKIN_HEADER_DATAFILE_ENTRIES,
+    SKIN_HEADER_DATAFILE_TABLE,
+    SKIN_HEADER_FIELDS
 };
-typedef struct _BOARDER _BOARDER;
+
+
+/** compiled skin page fields
+ */
+enum _SKIN_PAGE_FIELD {
+    SKIN_PAGE_DEPTH,
+    SKIN_PAGE_W,
+    SKIN_PAGE_H,
+    SKIN_PAGE_PIXELS,
+    SKIN_PAGE_FIELDS
+};
+
+
+/** compiled skin entry fields; the arguments are the boarder of textures,
+    the size of fonts and the type, frames and speed of animations
+ */
+enum _SKIN_ENTRY_FIELD {
+    SKIN_ENTRY_NAME,
+    SKIN_ENTRY_TYPE,
+    SKIN_ENTRY_LINK,
+    SKIN_ENTRY_PAGE,
+    SKIN_ENTRY_X,
+    SKIN_ENTRY_Y,
+    SKIN_ENTRY_W,
+    SKIN_ENTRY_H,
+    SKIN_ENTRY_ARG,
+    SKIN_ENTRY_DATA = SKIN_ENTRY_ARG + 4,
+    SKIN_ENTRY_SIZE,
+    SKIN_ENTRY_FIELDS
+};
+
+
+/** compiled skin datafile object fields
+ */
+enum _SKIN_DATAFILE_FIELD {
+    SKIN_DATAFILE_TYPE,
+    SKIN_DATAFILE_PAGE,
+    SKIN_DATAFILE_X,
+    SKIN_DATAFILE_Y,
+    SKIN_DATAFILE_W,
+    SKIN_DATAFILE_H,
+    SKIN_DATAFILE_DATA,
+    SKIN_DATAFILE_SIZE,
+    SKIN_DATAFILE_PROPS,
+    SKIN_DATAFILE_PROP_TABLE,
+    SKIN_DATAFILE_FIELDS
+};
+
+
+/** compiled skin datafile property fields
+ */
+enum _SKIN_PROPERTY_FIELD {
+    SKIN_PROPERTY_TYPE,
+    SKIN_PROPERTY_STRING,
+    SKIN_PROPERTY_FIELDS
+};
+
+
+/** datafile bitmap placed in an atlas
+ */
+struct _ATLAS_ITEM {
+    /* Datafile Index */
+    int idx;
+    /* Bitmap Size And Color Depth */
+    int w;
+    int h;
+    int depth;
+    /* Atlas Page And Position */
+    int page;
+    int x;
+    int y;
+};
+typedef struct _ATLAS_ITEM _ATLAS_ITEM;
+
+
+/** atlas bitmap being packed
+ */
+struct _ATLAS_PAGE {
+    /* Used Size And Color Depth */
+    int w;
+    int h;
+    int depth;
+    /* Number Of Bitmaps Placed */
+    int count;
+    /* Atlas Bitmap */
+    BITMAP *bmp;
+};
+typedef struct _ATLAS_PAGE _ATLAS_PAGE;
+
+
+/** compiled skin being written
+ */
+struct _SKIN_WRITER {
+    /* Skin Being Compiled */
+    AWE_SKIN *skn;
+    /* Objects In Name Order */
+    _SKIN_OBJECT **obj;
+    int obj_count;
+    /* Bitmaps Whose Pixels Are Written */
+    BITMAP **page;
+    int page_count;
+    /* File Image */
+    unsigned char *data;
+    long size;
+    long capacity;
+};
+typedef struct _SKIN_WRITER _SKIN_WRITER;
+
+
+/** object of a reloaded skin that widgets must be pointed to
+ */
+struct _SKIN_REBIND {
+    /* Data Of The Old Skin */
+    void *old_data;
+    /* Data Of The New Skin */
+    void *new_data;
+};
+typedef struct _SKIN_REBIND _SKIN_REBIND;
+
+
+/** color of a reloaded skin that has changed
+ */
+struct _SKIN_RECOLOR {
+    /* Color Of The Old Skin */
+    RGB old_col;
+    /* Color Of The New Skin With The Same Name */
+    RGB new_col;
+};
+typedef struct _SKIN_RECOLOR _SKIN_RECOLOR;
+
+
+/** skin being reloaded
+ */
+struct _SKIN_RELOAD {
+    /* Skin Being Reloaded */
+    AWE_SKIN *skn;
+    /* Objects To Rebind, Sorted By Old Data */
+    _SKIN_REBIND *rebind;
+    int rebind_count;
+    /* Textures Updated In Place With Different Pixels, Sorted */
+    void **changed;
+    int changed_count;
+    /* Colors That Have Changed */
+    _SKIN_RECOLOR *recolor;
+    int recolor_count;
+};
+typedef struct _SKIN_RELOAD _SKIN_RELOAD;
 
 
 static AWE_SKIN_ANIM _default_anim = { 0, 1, 0 };
@@ -86,8 +290,13 @@ static void _skin_destroy_texture(void *data){
 }
 
 
+static void _skin_destroy_bitmap(void *data){
+    destroy_bitmap((BITMAP*)data);
+}
+
+
 static void _skin_destroy_font(void *data){
-    destroy_font((FONT*)data);
+    awe_unload_font((FONT*)data);
 }
 
 
@@ -142,14 +351,133 @@ static void _get_dat_boarder(DATAFILE *dat, _BOARDER *boarder, int idx){
 }
 
 
-static _SKIN_OBJECT *_get_skin_object(AWE_SKIN *skn, const char *name){
+static unsigned _hash_name(const char *name, int size){
+    unsigned hash = 2166136261u;
+    while(size-- > 0)
+        hash = (hash ^ (unsigned char)*name++) * 16777619u;
+    return hash;
+}
+
+
+static void _count_skin_object(void *data, void *arg){
+    ((AWE_SKIN*)arg)->object_count++;
+}
+
+
+static void _collect_skin_object(void *data, void *arg){
+    AWE_SKIN *skn = (AWE_SKIN*)arg;
+    skn->objects[skn->object_count++] = data;
+}
+
+
+static void _skin_keep_func(const void *data){
+}
+
+
+/* builds the index of a loaded skin: the objects sorted by name, and a hash
+   table of their positions; the tree used while loading is released
+ */
+static int _build_skin_index(AWE_SKIN *skn){
+    _SKIN_OBJECT *obj;
+    int size, i, j;
+    if(!skn->objects){
+        awe_sbt_walk(skn->obj_list, _count_skin_object, skn);
+        if((skn->objects = (void**)malloc((skn->object_count + 1) * sizeof(void*))) == NULL)
+            return 0;
+        skn->object_count = 0;
+        awe_sbt_walk(skn->obj_list, _collect_skin_object, skn);
+        awe_sbt_destroy(&skn->obj_list, _skin_keep_func);
+    }
+    for(size = 16; size < skn->object_count * 2; size *= 2);
+    if((skn->hash = (int*)malloc(size * sizeof(int))) == NULL)
+        return 0;
+    skn->hash_mask = size - 1;
+    for(i = 0; i < size; i++)
+        skn->hash[i] = -1;
+    for(i = 0; i < skn->object_count; i++){
+        obj = (_SKIN_OBJECT*)skn->objects[i];
+        obj->hash = _hash_name(obj->name, ustrsize(obj->name));
+        for(j = obj->hash & skn->hash_mask; skn->hash[j] >= 0; j = (j + 1) & skn->hash_mask);
+        skn->hash[j] = i;
+    }
+    return 1;
+}
+
+
+static int _find_skin_handle(AWE_SKIN *skn, const char *name){
+    _SKIN_OBJECT *obj;
+    int size = ustrsize(name);
+    unsigned hash = _hash_name(name, size);
+    int i;
+    for(i = hash & skn->hash_mask; skn->hash[i] >= 0; i = (i + 1) & skn->hash_mask){
+        obj = (_SKIN_OBJECT*)skn->objects[skn->hash[i]];
+        if(obj->hash == hash && memcmp(obj->name, name, size) == 0 && ustrsize(obj->name) == size)
+            return skn->hash[i];
+    }
+    return -1;
+}
+
+
+static _SKIN_OBJECT *_find_skin_object(AWE_SKIN *skn, const char *name){
     _SKIN_OBJECT tmp;
+    int handle;
+    /* The tree is only used while loading */
+    if(skn->hash){
+        handle = _find_skin_handle(skn, name);
+        return handle >= 0 ? (_SKIN_OBJECT*)skn->objects[handle] : NULL;
+    }
     tmp.name = (char*)name;
     tmp.data = NULL;
     return awe_sbt_find(skn->obj_list, &tmp, _skin_compare_func);
 }
 
 
+/* creates the data of an object on its first use; textures, fonts and the
+   bitmaps of compiled skins are registered without their data
+ */
+static void _load_skin_object(_SKIN_OBJECT *obj){
+    if(obj->loaded)
+        return;
+    obj->loaded = TRUE;
+    if(obj->link){
+        /* Don't destroy linked data */
+        _load_skin_object(obj->link);
+        obj->data = obj->link->data;
+        return;
+    }
+    switch(obj->type){
+        case SKIN_TEXTURE:
+            TRACE("Skin: Creating texture %s\n", obj->name);
+            if((obj->data = awe_create_texture(obj->src, obj->x, obj->y, obj->w, obj->h, obj->boarder.left, obj->boarder.top, obj->boarder.right, obj->boarder.bottom)) != NULL)
+                obj->destroy_object = _skin_destroy_texture;
+        break;
+        case SKIN_BITMAP:
+            TRACE("Skin: Creating bitmap %s\n", obj->name);
+            if((obj->data = create_sub_bitmap(obj->src, obj->x, obj->y, obj->w, obj->h)) != NULL)
+                obj->destroy_object = _skin_destroy_bitmap;
+        break;
+        case SKIN_FONT:
+            TRACE("Skin: Creating font %s\n", obj->name);
+            obj->data = awe_load_memory_font(obj->font_data, obj->font_data_len, obj->font_size);
+            if(obj->data != font)
+                obj->destroy_object = _skin_destroy_font;
+        break;
+        default:
+        break;
+    }
+}
+
+
+static _SKIN_OBJECT *_get_skin_object(AWE_SKIN *skn, int handle){
+    _SKIN_OBJECT *obj;
+    if(handle < 0 || handle >= skn->object_count)
+        return NULL;
+    obj = (_SKIN_OBJECT*)skn->objects[handle];
+    _load_skin_object(obj);
+    return obj;
+}
+
+
 static int _test_byte_order(){
    short int word = 0x0001;
    char *byte = (char *) &word;
@@ -163,6 +491,140 @@ static unsigned long _byte_swap(unsigned long nLongNumber){
 }
 
 
+static int _is_bitmap_type(int type){
+    switch(type){
+        case DAT_ID('B', 'M', 'P', ' '):
+        case DAT_ID('T', 'G', 'A', ' '):
+        case DAT_ID('P', 'C', 'X', ' '):
+        #ifdef LOADPNG
+        case DAT_ID('P', 'N', 'G', ' '):
+        #endif
+            return 1;
+    }
+    return 0;
+}
+
+
+/* sorts atlas items by color depth, then by decreasing height, so as that
+   each shelf is filled with bitmaps of about the same height
+ */
+static int _atlas_compare_func(const void *a, const void *b){
+    const _ATLAS_ITEM *item1 = (const _ATLAS_ITEM*)a;
+    const _ATLAS_ITEM *item2 = (const _ATLAS_ITEM*)b;
+    if(item1->depth != item2->depth)
+        return item1->depth - item2->depth;
+    if(item1->h != item2->h)
+        return item2->h - item1->h;
+    return item1->idx - item2->idx;
+}
+
+
+static int _place_atlas_items(_ATLAS_ITEM *item, int count, _ATLAS_PAGE *page){
+    int i, x = 0, y = 0, shelf_h = 0, p = -1;
+    for(i = 0; i < count; i++){
+        /* Start a new shelf when the row is full */
+        if(p >= 0 && x + item[i].w > SKIN_ATLAS_SIZE){
+            y += shelf_h;
+            x = 0;
+            shelf_h = 0;
+        }
+        /* Start a new page when the depth changes or the page is full */
+        if(p < 0 || item[i].depth != page[p].depth || y + item[i].h > SKIN_ATLAS_SIZE){
+            p++;
+            page[p].w = 0;
+            page[p].h = 0;
+            page[p].depth = item[i].depth;
+            page[p].count = 0;
+            page[p].bmp = NULL;
+            x = 0;
+            y = 0;
+            shelf_h = 0;
+        }
+        item[i].page = p;
+        item[i].x = x;
+        item[i].y = y;
+        x += item[i].w;
+        shelf_h = MAX(shelf_h, item[i].h);
+        page[p].w = MAX(page[p].w, x);
+        page[p].h = MAX(page[p].h, y + item[i].h);
+        page[p].count++;
+    }
+    return p + 1;
+}
+
+
+/* copies the bitmaps of the datafile into a few atlas bitmaps; the datafile
+   objects are replaced with sub-bitmaps of the atlases, so as that textures,
+   cursors and bitmaps all reference the atlas pixels
+ */
+static int _pack_atlases(AWE_SKIN *skn){
+    _ATLAS_ITEM *item;
+    _ATLAS_PAGE *page = NULL;
+    BITMAP *bmp, *sub;
+    int count = 0, num_pages, i;
+    for(i = 0; skn->dat[i].type != DAT_END; i++){
+        if(_is_bitmap_type(skn->dat[i].type))
+            count++;
+    }
+    if(count < 2)
+        return 1;
+    if((item = (_ATLAS_ITEM*)malloc(count * sizeof(_ATLAS_ITEM))) == NULL)
+        return 0;
+    /* Collect memory bitmaps that fit in an atlas */
+    count = 0;
+    for(i = 0; skn->dat[i].type != DAT_END; i++){
+        if(!_is_bitmap_type(skn->dat[i].type))
+            continue;
+        bmp = (BITMAP*)skn->dat[i].dat;
+        if(!bmp || !is_memory_bitmap(bmp) || is_sub_bitmap(bmp))
+            continue;
+        if(bmp->w <= 0 || bmp->h <= 0 || bmp->w > SKIN_ATLAS_SIZE || bmp->h > SKIN_ATLAS_SIZE)
+            continue;
+        item[count].idx = i;
+        item[count].w = bmp->w;
+        item[count].h = bmp->h;
+        item[count].depth = bitmap_color_depth(bmp);
+        count++;
+    }
+    if(count < 2){
+        free(item);
+        return 1;
+    }
+    qsort(item, count, sizeof(_ATLAS_ITEM), _atlas_compare_func);
+    if((page = (_ATLAS_PAGE*)malloc(count * sizeof(_ATLAS_PAGE))) == NULL)
+        goto _skin_error;
+    num_pages = _place_atlas_items(item, count, page);
+    if((skn->atlas = (BITMAP**)malloc(num_pages * sizeof(BITMAP*))) == NULL)
+        goto _skin_error;
+    /* Create pages that hold more than one bitmap */
+    for(i = 0; i < num_pages; i++){
+        if(page[i].count < 2)
+            continue;
+        TRACE("Skin: Creating %dx%d atlas\n", page[i].w, page[i].h);
+        if((page[i].bmp = create_bitmap_ex(page[i].depth, page[i].w, page[i].h)) != NULL)
+            skn->atlas[skn->atlas_count++] = page[i].bmp;
+    }
+    /* Move bitmaps into their pages */
+    for(i = 0; i < count; i++){
+        if(!page[item[i].page].bmp)
+            continue;
+        if((sub = create_sub_bitmap(page[item[i].page].bmp, item[i].x, item[i].y, item[i].w, item[i].h)) == NULL)
+            continue;
+        bmp = (BITMAP*)skn->dat[item[i].idx].dat;
+        blit(bmp, sub, 0, 0, 0, 0, bmp->w, bmp->h);
+        destroy_bitmap(bmp);
+        skn->dat[item[i].idx].dat = sub;
+    }
+    free(page);
+    free(item);
+    return 1;
+    _skin_error:
+    free(page);
+    free(item);
+    return 0;
+}
+
+
 static int _generate_skin_texture(AWE_SKIN *skn, BITMAP *base, _BOARDER *boarder, const char *name, int idx, int startframe, int numframes, int animframes, _SKIN_TILE_METHOD basetile, _SKIN_TILE_METHOD animtile){
     int offsetx = animtile ? 0 : base->w / numframes;
     int offsety = animtile ? base->h / numframes : 0;
@@ -174,7 +636,7 @@ static int _generate_skin_texture(AWE_SKIN *skn, BITMAP *base, _BOARDER *boarder
     _SKIN_OBJECT *obj;
     int i;
     for(i = 0; i < animframes; i++){
-        if((obj = (_SKIN_OBJECT*)malloc(sizeof(_SKIN_OBJECT))) == NULL)
+        if((obj = (_SKIN_OBJECT*)calloc(1, sizeof(_SKIN_OBJECT))) == NULL)
             goto _skin_error;
         if(animframes == 1){
             if((obj->name = (char*)malloc(ustrlen(name) + uwidth_max(U_CURRENT))) == NULL)
@@ -189,10 +651,13 @@ static int _generate_skin_texture(AWE_SKIN *skn, BITMAP *base, _BOARDER *boarder
         }
         obj->type = SKIN_TEXTURE;
         obj->skin_idx = idx;
-        obj->destroy_object = _skin_destroy_texture;
+        obj->src = base;
+        obj->x = startx;
+        obj->y = starty;
+        obj->w = texturew;
+        obj->h = textureh;
+        obj->boarder = *boarder;
         TRACE("Skin: Loading %s as texture\n", obj->name);
-        if(((AWE_TEXTURE*)obj->data = awe_create_texture(base, startx, starty, texturew, textureh, boarder->left, boarder->top, boarder->right, boarder->bottom)) == NULL)
-            goto _skin_error;
         awe_sbt_insert(&skn->obj_list, obj, _skin_compare_func);
         startx += offsetx;
         starty += offsety;
@@ -209,7 +674,7 @@ static int _generate_skin_texture(AWE_SKIN *skn, BITMAP *base, _BOARDER *boarder
 static int _create_animation(AWE_SKIN *skn, const char *name, AWE_SKIN_ANIM_TYPE type, int numframes, int speed){
     _SKIN_OBJECT *obj;
     char *anim = "Anim";
-    if((obj = (_SKIN_OBJECT*)malloc(sizeof(_SKIN_OBJECT))) == NULL)
+    if((obj = (_SKIN_OBJECT*)calloc(1, sizeof(_SKIN_OBJECT))) == NULL)
         goto _skin_error;
     if((obj->name = (char*)malloc(ustrlen(name) + ustrlen(anim) + uwidth(".") + uwidth_max(U_CURRENT))) == NULL)
         goto _skin_error;
@@ -223,6 +688,7 @@ static int _create_animation(AWE_SKIN *skn, const char *name, AWE_SKIN_ANIM_TYPE
     obj->skin_idx = -1;
     obj->type = SKIN_ANIM;
     obj->destroy_object = _skin_destroy_data;
+    obj->loaded = TRUE;
     awe_sbt_insert(&skn->obj_list, obj, _skin_compare_func);
     return 1;
     _skin_error:
@@ -251,7 +717,7 @@ static int _load_texture_references(AWE_SKIN *skn){
                     TRACE("Skin: Warning - No Reference Specified\n");
                     continue;
                 }
-                if((tmp = _get_skin_object(skn, name)) == NULL){
+                if((tmp = _find_skin_object(skn, name)) == NULL){
                     TRACE("Skin: Warning - Reference %s Not Found\n", name);
                     continue;
                 }
@@ -279,7 +745,7 @@ static int _load_texture_references(AWE_SKIN *skn){
                 if(*name == '\0')
                     continue;
                 else{ 
-                    if(!_generate_skin_texture(skn, tmp->data, &boarder, name, i, start_frame, num_frames, anim_frames, base_tile, anim_tile))
+                    if(!_generate_skin_texture(skn, tmp->src, &boarder, name, i, start_frame, num_frames, anim_frames, base_tile, anim_tile))
                         return 0;
                     if(anim_frames > 1){
                         if(!_create_animation(skn, name, anim_type, anim_frames, anim_speed))
@@ -305,7 +771,7 @@ static int _load_objects(AWE_SKIN *skn){
         /* Skip references */
         if(skn->dat[i].type == DAT_ID('R', 'E', 'F', ' '))
             continue;
-        if((obj = (_SKIN_OBJECT*)malloc(sizeof(_SKIN_OBJECT))) == NULL)
+        if((obj = (_SKIN_OBJECT*)calloc(1, sizeof(_SKIN_OBJECT))) == NULL)
             goto _skin_error;
         obj->skin_idx = i;
         if((obj->name = (char*)malloc(ustrlen(name) + uwidth_max(U_CURRENT))) == NULL)
@@ -321,35 +787,37 @@ static int _load_objects(AWE_SKIN *skn){
                 name = get_datafile_property(skn->dat + i, DAT_ID('T', 'Y', 'P', 'E'));
                 if(ustricmp(name, "texture") == 0){
                     TRACE("Skin: Loading %s as texture\n", obj->name);
-                    /* Create texture */
+                    /* The texture is created on first use */
                     _get_dat_boarder(skn->dat, &boarder, i);
                     obj->type = SKIN_TEXTURE;
-                    if(((AWE_TEXTURE*)obj->data = awe_create_texture((BITMAP*)skn->dat[i].dat, 0, 0, ((BITMAP*)(skn->dat[i].dat))->w, ((BITMAP*)(skn->dat[i].dat))->h, boarder.left, boarder.top, boarder.right, boarder.bottom)) == NULL)
-                        goto _skin_error;
-                    obj->destroy_object = _skin_destroy_texture;
+                    obj->boarder = boarder;
                 }
                 else{
                     TRACE("Skin: Loading %s as bitmap\n", obj->name);
                     obj->type = SKIN_BITMAP;
                     obj->data = skn->dat[i].dat;
                     obj->destroy_object = NULL;
+                    obj->loaded = TRUE;
                 }
+                obj->src = (BITMAP*)skn->dat[i].dat;
+                obj->w = obj->src->w;
+                obj->h = obj->src->h;
             break;
             case DAT_ID('T', 'T', 'F', ' '):
                 TRACE("Skin: Loading %s as true type font\n", obj->name);
                 name = get_datafile_property(skn->dat + i, DAT_ID('S', 'I', 'Z', 'E'));
                 obj->type = SKIN_FONT;
-                obj->data = awe_load_memory_font((const char *)skn->dat[i].dat, skn->dat[i].size, *name == '\0' ? 12 : atoi(name));
-                if(obj->data == font)
-	            obj->destroy_object = NULL;
-		else
-		    obj->destroy_object = _skin_destroy_font;
+                /* The font is loaded on first use */
+                obj->font_data = (const char *)skn->dat[i].dat;
+                obj->font_data_len = skn->dat[i].size;
+                obj->font_size = *name == '\0' ? 12 : atoi(name);
             break;
             default:
                 TRACE("Skin: Loading %s as binary\n", obj->name);
                 obj->type = skn->dat[i].type;
                 obj->data = skn->dat[i].dat;
                 obj->destroy_object = NULL;
+                obj->loaded = TRUE;
             break;
         }
         awe_sbt_insert(&skn->obj_list, obj, _skin_compare_func);
@@ -380,7 +848,7 @@ static int _load_references(AWE_SKIN *skn){
                 TRACE("Skin: Warning - No Reference Specified\n");
                 continue;
             }
-            if((tmp = _get_skin_object(skn, name)) == NULL){
+            if((tmp = _find_skin_object(skn, name)) == NULL){
                 TRACE("Skin: Warning - Reference %s Not Found\n", name);
                 continue;
             }
@@ -388,14 +856,14 @@ static int _load_references(AWE_SKIN *skn){
             if(*name == '\0')
                 continue;
             TRACE("Skin: Loading %s as binary data link\n", name);
-            if((obj = (_SKIN_OBJECT*)malloc(sizeof(_SKIN_OBJECT))) == NULL)
+            if((obj = (_SKIN_OBJECT*)calloc(1, sizeof(_SKIN_OBJECT))) == NULL)
                 goto _skin_error;
             if((obj->name = (char*)malloc(ustrlen(name) + uwidth_max(U_CURRENT))) == NULL)
                 goto _skin_error;
             ustrcpy(obj->name, name);
             obj->skin_idx = i;
             obj->type = tmp->type;
-            obj->data = tmp->data;
+            obj->link = tmp->link ? tmp->link : tmp;
             /* Don't destroy linked data */
             obj->destroy_object = NULL;
             awe_sbt_insert(&skn->obj_list, obj, _skin_compare_func);
@@ -410,43 +878,621 @@ static int _load_references(AWE_SKIN *skn){
 }
 
 
-/*****************************************************************************
-    PUBLIC
- *****************************************************************************/
+static void _put_long(unsigned char *p, long val){
+    p[0] = (unsigned char)val;
+    p[1] = (unsigned char)(val >> 8);
+    p[2] = (unsigned char)(val >> 16);
+    p[3] = (unsigned char)(val >> 24);
+}
 
 
-AWE_SKIN *awe_load_skin(const char *filename){
+static long _get_long(const unsigned char *p){
+    return (long)(p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned long)p[3] << 24));
+}
+
+
+/* appends zeroed space to the file image, aligned to 4 bytes; returns the
+   offset of the space or -1 if out of memory
+ */
+static long _reserve(_SKIN_WRITER *w, long size){
+    unsigned char *data;
+    long pos = (w->size + 3) & ~3L;
+    long capacity = w->capacity;
+    while(pos + size > capacity)
+        capacity = capacity * 2 + 4096;
+    if(capacity != w->capacity){
+        if((data = (unsigned char*)realloc(w->data, capacity)) == NULL)
+            return -1;
+        w->data = data;
+        w->capacity = capacity;
+    }
+    memset(w->data + w->size, 0, pos + size - w->size);
+    w->size = pos + size;
+    return pos;
+}
+
+
+static long _add_data(_SKIN_WRITER *w, const void *data, long size){
+    long pos;
+    if((pos = _reserve(w, size)) < 0)
+        return -1;
+    memcpy(w->data + pos, data, size);
+    return pos;
+}
+
+
+static void _put_field(_SKIN_WRITER *w, long pos, int field, long val){
+    _put_long(w->data + pos + field * 4, val);
+}
+
+
+/* returns the page a bitmap's pixels are written to, and the position of the
+   bitmap in the page; bitmaps that are not in an atlas become pages
+ */
+static int _find_page(_SKIN_WRITER *w, BITMAP *bmp, int *x, int *y){
+    BITMAP *page;
+    int i, bpp = (bitmap_color_depth(bmp) + 7) / 8;
+    for(i = 0; i < w->page_count; i++){
+        page = w->page[i];
+        *x = 0;
+        *y = 0;
+        if(page == bmp)
+            return i;
+        if(!is_sub_bitmap(bmp) || is_sub_bitmap(page) || bitmap_color_depth(page) != bitmap_color_depth(bmp))
+            continue;
+        if(bmp->line[0] >= page->line[0] && bmp->line[0] < page->line[page->h - 1] + page->w * bpp){
+            *x = bmp->x_ofs;
+            *y = bmp->y_ofs;
+            return i;
+        }
+    }
+    w->page[w->page_count] = bmp;
+    return w->page_count++;
+}
+
+
+static int _is_blob_type(int type){
+    switch(type){
+        case DAT_FILE:
+        case DAT_FONT:
+        case DAT_SAMPLE:
+        case DAT_MIDI:
+        case DAT_PATCH:
+        case DAT_FLI:
+        case DAT_RLE_SPRITE:
+        case DAT_C_SPRITE:
+        case DAT_XC_SPRITE:
+        case DAT_PALETTE:
+            return 0;
+    }
+    return !_is_bitmap_type(type);
+}
+
+
+/* datafile objects kept in a compiled skin: bitmaps, and the data that is not
+   a skin object, such as the cursor configuration
+ */
+static int _is_compiled_datafile_object(DATAFILE *dat){
+    if(_is_bitmap_type(dat->type))
+        return 1;
+    return _is_blob_type(dat->type) && *get_datafile_property(dat, DAT_ID('A', 'W', 'E', ' ')) == '\0';
+}
+
+
+static int _write_skin_entry(_SKIN_WRITER *w, long pos, _SKIN_OBJECT *obj){
+    DATAFILE *dat = obj->skin_idx >= 0 ? w->skn->dat + obj->skin_idx : NULL;
+    const char *size;
+    long data;
+    int page, x, y;
+    if((data = _add_data(w, obj->name, ustrsizez(obj->name))) < 0)
+        return 0;
+    _put_field(w, pos, SKIN_ENTRY_NAME, data);
+    _put_field(w, pos, SKIN_ENTRY_TYPE, obj->type);
+    _put_field(w, pos, SKIN_ENTRY_LINK, obj->link ? _find_skin_handle(w->skn, obj->link->name) : -1);
+    _put_field(w, pos, SKIN_ENTRY_PAGE, -1);
+    if(obj->link)
+        return 1;
+    switch(obj->type){
+        case SKIN_TEXTURE:
+        case SKIN_BITMAP:
+            page = _find_page(w, obj->src, &x, &y);
+            _put_field(w, pos, SKIN_ENTRY_PAGE, page);
+            _put_field(w, pos, SKIN_ENTRY_X, x + obj->x);
+            _put_field(w, pos, SKIN_ENTRY_Y, y + obj->y);
+            _put_field(w, pos, SKIN_ENTRY_W, obj->w);
+            _put_field(w, pos, SKIN_ENTRY_H, obj->h);
+            _put_field(w, pos, SKIN_ENTRY_ARG + 0, obj->boarder.left);
+            _put_field(w, pos, SKIN_ENTRY_ARG + 1, obj->boarder.top);
+            _put_field(w, pos, SKIN_ENTRY_ARG + 2, obj->boarder.right);
+            _put_field(w, pos, SKIN_ENTRY_ARG + 3, obj->boarder.bottom);
+            return 1;
+        case SKIN_ANIM:
+            _put_field(w, pos, SKIN_ENTRY_ARG + 0, ((AWE_SKIN_ANIM*)obj->data)->type);
+            _put_field(w, pos, SKIN_ENTRY_ARG + 1, ((AWE_SKIN_ANIM*)obj->data)->numframes);
+            _put_field(w, pos, SKIN_ENTRY_ARG + 2, ((AWE_SKIN_ANIM*)obj->data)->speed);
+            return 1;
+        case SKIN_FONT:
+            size = get_datafile_property(dat, DAT_ID('S', 'I', 'Z', 'E'));
+            _put_field(w, pos, SKIN_ENTRY_ARG, *size == '\0' ? 12 : atoi(size));
+        break;
+        default:
+        break;
+    }
+    /* Everything else is kept as the raw datafile object */
+    if(!dat)
+        return 1;
+    if((data = _add_data(w, dat->dat, dat->size)) < 0)
+        return 0;
+    _put_field(w, pos, SKIN_ENTRY_DATA, data);
+    _put_field(w, pos, SKIN_ENTRY_SIZE, dat->size);
+    return 1;
+}
+
+
+static int _write_datafile_entry(_SKIN_WRITER *w, long pos, DATAFILE *dat){
+    DATAFILE_PROPERTY *prop;
+    long table, data;
+    int num_props = 0, page, x, y, i;
+    _put_field(w, pos, SKIN_DATAFILE_TYPE, dat->type);
+    _put_field(w, pos, SKIN_DATAFILE_PAGE, -1);
+    if(_is_bitmap_type(dat->type)){
+        page = _find_page(w, (BITMAP*)dat->dat, &x, &y);
+        _put_field(w, pos, SKIN_DATAFILE_PAGE, page);
+        _put_field(w, pos, SKIN_DATAFILE_X, x);
+        _put_field(w, pos, SKIN_DATAFILE_Y, y);
+        _put_field(w, pos, SKIN_DATAFILE_W, ((BITMAP*)dat->dat)->w);
+        _put_field(w, pos, SKIN_DATAFILE_H, ((BITMAP*)dat->dat)->h);
+    }
+    else{
+        if((data = _add_data(w, dat->dat, dat->size)) < 0)
+            return 0;
+        _put_field(w, pos, SKIN_DATAFILE_DATA, data);
+        _put_field(w, pos, SKIN_DATAFILE_SIZE, dat->size);
+    }
+    for(prop = dat->prop; prop && prop->type != DAT_END; prop++)
+        num_props++;
+    if((table = _reserve(w, num_props * SKIN_PROPERTY_FIELDS * 4)) < 0)
+        return 0;
+    _put_field(w, pos, SKIN_DATAFILE_PROPS, num_props);
+    _put_field(w, pos, SKIN_DATAFILE_PROP_TABLE, table);
+    for(i = 0; i < num_props; i++){
+        if((data = _add_data(w, dat->prop[i].dat, ustrsizez(dat->prop[i].dat))) < 0)
+            return 0;
+        _put_field(w, table + i * SKIN_PROPERTY_FIELDS * 4, SKIN_PROPERTY_TYPE, dat->prop[i].type);
+        _put_field(w, table + i * SKIN_PROPERTY_FIELDS * 4, SKIN_PROPERTY_STRING, data);
+    }
+    return 1;
+}
+
+
+static int _write_pages(_SKIN_WRITER *w, long header){
+    BITMAP *page;
+    long table, pixels, pitch;
+    int i, y;
+    if((table = _reserve(w, w->page_count * SKIN_PAGE_FIELDS * 4)) < 0)
+        return 0;
+    _put_field(w, header, SKIN_HEADER_PAGES, w->page_count);
+    _put_field(w, header, SKIN_HEADER_PAGE_TABLE, table);
+    for(i = 0; i < w->page_count; i++){
+        page = w->page[i];
+        pitch = (long)page->w * ((bitmap_color_depth(page) + 7) / 8);
+        if((pixels = _reserve(w, pitch * page->h)) < 0)
+            return 0;
+        for(y = 0; y < page->h; y++)
+            memcpy(w->data + pixels + y * pitch, page->line[y], pitch);
+        _put_field(w, table + i * SKIN_PAGE_FIELDS * 4, SKIN_PAGE_DEPTH, bitmap_color_depth(page));
+        _put_field(w, table + i * SKIN_PAGE_FIELDS * 4, SKIN_PAGE_W, page->w);
+        _put_field(w, table + i * SKIN_PAGE_FIELDS * 4, SKIN_PAGE_H, page->h);
+        _put_field(w, table + i * SKIN_PAGE_FIELDS * 4, SKIN_PAGE_PIXELS, pixels);
+    }
+    return 1;
+}
+
+
+static int _write_compiled_skin(_SKIN_WRITER *w){
+    AWE_SKIN *skn = w->skn;
+    long header, entries, datafile;
+    int i, count = 0, flags = 0;
+    /* The index holds the objects in name order */
+    w->obj = (_SKIN_OBJECT**)skn->objects;
+    w->obj_count = skn->object_count;
+    for(i = 0; skn->dat[i].type != DAT_END; i++){
+        if(_is_compiled_datafile_object(skn->dat + i))
+            count++;
+    }
+    /* Atlases come first; other bitmaps are added as they are found */
+    if((w->page = (BITMAP**)malloc((skn->atlas_count + w->obj_count + count + 1) * sizeof(BITMAP*))) == NULL)
+        return 0;
+    for(i = 0; i < skn->atlas_count; i++)
+        w->page[w->page_count++] = skn->atlas[i];
+    i = _get_dat_idx(skn->dat, "ALPHA_CFG");
+    if(_get_dat_int(skn->dat, i, DAT_ID('C', 'F', 'G', 'A'), 0))
+        flags |= SKIN_COMPILED_ALPHA;
+    if(_test_byte_order() == BIG_ENDIAN)
+        flags |= SKIN_COMPILED_BIG_ENDIAN;
+    if((header = _reserve(w, SKIN_HEADER_FIELDS * 4)) < 0)
+        return 0;
+    if((entries = _reserve(w, w->obj_count * SKIN_ENTRY_FIELDS * 4)) < 0)
+        return 0;
+    if((datafile = _reserve(w, count * SKIN_DATAFILE_FIELDS * 4)) < 0)
+        return 0;
+    _put_field(w, header, SKIN_HEADER_MAGIC, SKIN_COMPILED_MAGIC);
+    _put_field(w, header, SKIN_HEADER_VERSION, SKIN_COMPILED_VERSION);
+    _put_field(w, header, SKIN_HEADER_FLAGS, flags);
+    _put_field(w, header, SKIN_HEADER_ENTRIES, w->obj_count);
+    _put_field(w, header, SKIN_HEADER_ENTRY_TABLE, entries);
+    _put_field(w, header, SKIN_HEADER_DATAFILE_ENTRIES, count);
+    _put_field(w, header, SKIN_HEADER_DATAFILE_TABLE, datafile);
+    for(i = 0; i < w->obj_count; i++){
+        if(!_write_skin_entry(w, entries + i * SKIN_ENTRY_FIELDS * 4, w->obj[i]))
+            return 0;
+    }
+    count = 0;
+    for(i = 0; skn->dat[i].type != DAT_END; i++){
+        if(!_is_compiled_datafile_object(skn->dat + i))
+            continue;
+        if(!_write_datafile_entry(w, datafile + count * SKIN_DATAFILE_FIELDS * 4, skn->dat + i))
+            return 0;
+        count++;
+    }
+    return _write_pages(w, header);
+}
+
+
+/* checks that a range lies inside the compiled skin image
+ */
+static int _in_image(long size, long pos, long len){
+    return pos >= 0 && len >= 0 && pos <= size && len <= size - pos;
+}
+
+
+/* checks that a string starts inside the compiled skin image and ends
+   before the end of it; the image is padded with zeros, so as that the
+   last character can be decoded safely
+ */
+static int _in_image_string(const unsigned char *image, long size, long pos){
+    const char *p, *end = (const char*)image + size;
+    if(!_in_image(size, pos, 1))
+        return 0;
+    for(p = (const char*)image + pos; p < end; p += uwidth(p)){
+        if(ugetc(p) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+
+static int _get_field(const unsigned char *image, long pos, int field){
+    return (int)_get_long(image + pos + field * 4);
+}
+
+
+static int _load_compiled_pages(AWE_SKIN *skn, long size){
+    const unsigned char *image = (const unsigned char*)skn->image;
+    BITMAP *bmp, *tmp;
+    long table, pos, pixels, pitch;
+    int count, depth, w, h, flags, i, y;
+    count = _get_field(image, 0, SKIN_HEADER_PAGES);
+    table = _get_field(image, 0, SKIN_HEADER_PAGE_TABLE);
+    flags = _get_field(image, 0, SKIN_HEADER_FLAGS);
+    if(count < 0 || !_in_image(size, table, (long)count * SKIN_PAGE_FIELDS * 4))
+        return 0;
+    if((skn->atlas = (BITMAP**)malloc((count + 1) * sizeof(BITMAP*))) == NULL)
+        return 0;
+    for(i = 0; i < count; i++){
+        pos = table + i * SKIN_PAGE_FIELDS * 4;
+        depth = _get_field(image, pos, SKIN_PAGE_DEPTH);
+        w = _get_field(image, pos, SKIN_PAGE_W);
+        h = _get_field(image, pos, SKIN_PAGE_H);
+        pixels = _get_field(image, pos, SKIN_PAGE_PIXELS);
+        if((depth != 8 && depth != 15 && depth != 16 && depth != 24 && depth != 32) || w <= 0 || h <= 0)
+            return 0;
+        pitch = (long)w * ((depth + 7) / 8);
+        if(!_in_image(size, pixels, pitch * h))
+            return 0;
+        if((bmp = create_bitmap_ex(depth, w, h)) == NULL)
+            return 0;
+        for(y = 0; y < h; y++)
+            memcpy(bmp->line[y], image + pixels + y * pitch, pitch);
+        /* Convert to the current depth, as loading the datafile would */
+        if(!(flags & SKIN_COMPILED_ALPHA) && depth != get_color_depth()){
+            if((tmp = create_bitmap(w, h)) == NULL){
+                destroy_bitmap(bmp);
+                return 0;
+            }
+            blit(bmp, tmp, 0, 0, 0, 0, w, h);
+            destroy_bitmap(bmp);
+            bmp = tmp;
+        }
+        skn->atlas[skn->atlas_count++] = bmp;
+    }
+    return 1;
+}
+
+
+/* checks that an area lies in a page
+ */
+static int _in_page(AWE_SKIN *skn, int page, int x, int y, int w, int h){
+    BITMAP *bmp;
+    if(page < 0 || page >= skn->atlas_count)
+        return 0;
+    bmp = skn->atlas[page];
+    return x >= 0 && y >= 0 && w > 0 && h > 0 && x <= bmp->w - w && y <= bmp->h - h;
+}
+
+
+/* creates a sub-bitmap of a page, if the area lies in it
+ */
+static BITMAP *_create_page_bitmap(AWE_SKIN *skn, int page, int x, int y, int w, int h){
+    if(!_in_page(skn, page, x, y, w, h))
+        return NULL;
+    return create_sub_bitmap(skn->atlas[page], x, y, w, h);
+}
+
+
+static void _unload_compiled_datafile(DATAFILE *dat){
+    int i;
+    for(i = 0; dat[i].type != DAT_END; i++){
+        if(_is_bitmap_type(dat[i].type) && dat[i].dat)
+            destroy_bitmap((BITMAP*)dat[i].dat);
+    }
+    free(dat);
+}
+
+
+/* builds the datafile of a compiled skin; the datafile and its properties
+   are one allocation, and data and property strings point into the image
+ */
+static int _load_compiled_datafile(AWE_SKIN *skn, long size){
+    unsigned char *image = (unsigned char*)skn->image;
+    DATAFILE *dat;
+    DATAFILE_PROPERTY *prop;
+    long table, pos, props, data;
+    int count, num_props = 0, n, i, j;
+    count = _get_field(image, 0, SKIN_HEADER_DATAFILE_ENTRIES);
+    table = _get_field(image, 0, SKIN_HEADER_DATAFILE_TABLE);
+    if(count < 0 || !_in_image(size, table, (long)count * SKIN_DATAFILE_FIELDS * 4))
+        return 0;
+    for(i = 0; i < count; i++){
+        pos = table + i * SKIN_DATAFILE_FIELDS * 4;
+        n = _get_field(image, pos, SKIN_DATAFILE_PROPS);
+        if(n < 0 || !_in_image(size, _get_field(image, pos, SKIN_DATAFILE_PROP_TABLE), (long)n * SKIN_PROPERTY_FIELDS * 4))
+            return 0;
+        num_props += n + 1;
+    }
+    if((dat = (DATAFILE*)calloc(1, (count + 1) * sizeof(DATAFILE) + num_props * sizeof(DATAFILE_PROPERTY))) == NULL)
+        return 0;
+    prop = (DATAFILE_PROPERTY*)(dat + count + 1);
+    dat[count].type = DAT_END;
+    skn->dat = dat;
+    for(i = 0; i < count; i++){
+        pos = table + i * SKIN_DATAFILE_FIELDS * 4;
+        dat[i].type = _get_field(image, pos, SKIN_DATAFILE_TYPE);
+        dat[i].prop = prop;
+        n = _get_field(image, pos, SKIN_DATAFILE_PROPS);
+        props = _get_field(image, pos, SKIN_DATAFILE_PROP_TABLE);
+        for(j = 0; j < n; j++){
+            data = _get_field(image, props + j * SKIN_PROPERTY_FIELDS * 4, SKIN_PROPERTY_STRING);
+            if(!_in_image_string(image, size, data))
+                return 0;
+            prop->type = _get_field(image, props + j * SKIN_PROPERTY_FIELDS * 4, SKIN_PROPERTY_TYPE);
+            prop->dat = (char*)image + data;
+            prop++;
+        }
+        prop->type = DAT_END;
+        prop++;
+        if(_is_bitmap_type(dat[i].type)){
+            if((dat[i].dat = _create_page_bitmap(skn, _get_field(image, pos, SKIN_DATAFILE_PAGE), _get_field(image, pos, SKIN_DATAFILE_X), _get_field(image, pos, SKIN_DATAFILE_Y), _get_field(image, pos, SKIN_DATAFILE_W), _get_field(image, pos, SKIN_DATAFILE_H))) == NULL)
+                return 0;
+        }
+        else{
+            data = _get_field(image, pos, SKIN_DATAFILE_DATA);
+            dat[i].size = _get_field(image, pos, SKIN_DATAFILE_SIZE);
+            if(!_in_image(size, data, dat[i].size))
+                return 0;
+            dat[i].dat = image + data;
+        }
+    }
+    return 1;
+}
+
+
+static _SKIN_OBJECT *_create_compiled_object(AWE_SKIN *skn, long size, long pos, _SKIN_OBJECT **objects){
+    unsigned char *image = (unsigned char*)skn->image;
+    _SKIN_OBJECT *obj, *link;
+    long name = _get_field(image, pos, SKIN_ENTRY_NAME);
+    long data = _get_field(image, pos, SKIN_ENTRY_DATA);
+    long data_size = _get_field(image, pos, SKIN_ENTRY_SIZE);
+    int i, arg[4];
+    if(!_in_image_string(image, size, name) || !_in_image(size, data, data_size))
+        return NULL;
+    for(i = 0; i < 4; i++)
+        arg[i] = _get_field(image, pos, SKIN_ENTRY_ARG + i);
+    if((obj = (_SKIN_OBJECT*)calloc(1, sizeof(_SKIN_OBJECT))) == NULL)
+        return NULL;
+    if((obj->name = (char*)malloc(ustrsizez((char*)image + name))) == NULL)
+        goto _skin_error;
+    ustrcpy(obj->name, (char*)image + name);
+    obj->type = _get_field(image, pos, SKIN_ENTRY_TYPE);
+    obj->skin_idx = -1;
+    i = _get_field(image, pos, SKIN_ENTRY_LINK);
+    if(i >= 0){
+        /* Don't destroy linked data */
+        link = objects[i];
+        obj->type = link->type;
+        obj->link = link;
+        return obj;
+    }
+    obj->x = _get_field(image, pos, SKIN_ENTRY_X);
+    obj->y = _get_field(image, pos, SKIN_ENTRY_Y);
+    obj->w = _get_field(image, pos, SKIN_ENTRY_W);
+    obj->h = _get_field(image, pos, SKIN_ENTRY_H);
+    switch(obj->type){
+        case SKIN_TEXTURE:
+            i = _get_field(image, pos, SKIN_ENTRY_PAGE);
+            if(!_in_page(skn, i, obj->x, obj->y, obj->w, obj->h))
+                goto _skin_error;
+            obj->src = skn->atlas[i];
+            obj->boarder.left = arg[0];
+            obj->boarder.top = arg[1];
+            obj->boarder.right = arg[2];
+            obj->boarder.bottom = arg[3];
+        break;
+        case SKIN_BITMAP:
+            i = _get_field(image, pos, SKIN_ENTRY_PAGE);
+            if(!_in_page(skn, i, obj->x, obj->y, obj->w, obj->h))
+                goto _skin_error;
+            obj->src = skn->atlas[i];
+        break;
+        case SKIN_FONT:
+            obj->font_data = (const char*)image + data;
+            obj->font_data_len = data_size;
+            obj->font_size = arg[0];
+        break;
+        case SKIN_ANIM:
+            if((obj->data = malloc(sizeof(AWE_SKIN_ANIM))) == NULL)
+                goto _skin_error;
+            ((AWE_SKIN_ANIM*)(obj->data))->type = arg[0];
+            ((AWE_SKIN_ANIM*)(obj->data))->numframes = arg[1];
+            ((AWE_SKIN_ANIM*)(obj->data))->speed = arg[2];
+            obj->destroy_object = _skin_destroy_data;
+            obj->loaded = TRUE;
+        break;
+        default:
+            obj->data = image + data;
+            obj->loaded = TRUE;
+        break;
+    }
+    return obj;
+    _skin_error:
+    free(obj->name);
+    free(obj);
+    return NULL;
+}
+
+
+static int _load_compiled_objects(AWE_SKIN *skn, long size){
+    const unsigned char *image = (const unsigned char*)skn->image;
+    _SKIN_OBJECT **objects;
+    long table, pos;
+    int count, pass, i, link;
+    count = _get_field(image, 0, SKIN_HEADER_ENTRIES);
+    table = _get_field(image, 0, SKIN_HEADER_ENTRY_TABLE);
+    if(count < 0 || !_in_image(size, table, (long)count * SKIN_ENTRY_FIELDS * 4))
+        return 0;
+    if((objects = (_SKIN_OBJECT**)calloc(count + 1, sizeof(_SKIN_OBJECT*))) == NULL)
+        return 0;
+    /* Entries are sorted by name, so as that they are the index */
+    skn->objects = (void**)objects;
+    skn->object_count = count;
+    /* Objects first, then the links to them */
+    for(pass = 0; pass < 2; pass++){
+        for(i = 0; i < count; i++){
+            pos = table + i * SKIN_ENTRY_FIELDS * 4;
+            link = _get_field(image, pos, SKIN_ENTRY_LINK);
+            if((link >= 0) != pass)
+                continue;
+            if(link >= count || (pass && (!objects[link] || objects[link]->link)))
+                return 0;
+            if((objects[i] = _create_compiled_object(skn, size, pos, objects)) == NULL)
+                return 0;
+        }
+    }
+    return 1;
+}
+
+
+/* loads a compiled skin; returns -1 if the file is not a compiled skin
+ */
+static int _load_compiled_skin(AWE_SKIN *skn, const char *filename){
+    PACKFILE *f;
+    long size;
+    int flags;
+    size = (long)file_size_ex(filename);
+    if(size < SKIN_HEADER_FIELDS * 4)
+        return -1;
+    if((f = pack_fopen(filename, F_READ)) == NULL)
+        return -1;
+    if(pack_igetl(f) != SKIN_COMPILED_MAGIC){
+        pack_fclose(f);
+        return -1;
+    }
+    TRACE("Skin: Loading compiled skin %s\n", filename);
+    if((skn->image = calloc(1, size + SKIN_IMAGE_PADDING)) == NULL){
+        pack_fclose(f);
+        return 0;
+    }
+    /* One read for the whole image */
+    _put_long((unsigned char*)skn->image, SKIN_COMPILED_MAGIC);
+    if(pack_fread((unsigned char*)skn->image + 4, size - 4, f) != size - 4){
+        pack_fclose(f);
+        return 0;
+    }
+    pack_fclose(f);
+    flags = _get_field((unsigned char*)skn->image, 0, SKIN_HEADER_FLAGS);
+    if(_get_field((unsigned char*)skn->image, 0, SKIN_HEADER_VERSION) != SKIN_COMPILED_VERSION)
+        return 0;
+    if(((flags & SKIN_COMPILED_BIG_ENDIAN) != 0) != (_test_byte_order() == BIG_ENDIAN)){
+        TRACE("Skin: Compiled skin is of another byte order\n");
+        return 0;
+    }
+    if(!_load_compiled_pages(skn, size))
+        return 0;
+    if(!_load_compiled_datafile(skn, size))
+        return 0;
+    return _load_compiled_objects(skn, size);
+}
+
+
+static AWE_SKIN *_load_skin(const char *filename, int load_mouse){
     AWE_SKIN *skn;
-    int i, alpha = 0;
-    skn = (AWE_SKIN*)malloc(sizeof(AWE_SKIN));
+    DATAFILE *cfg;
+    const char *tmp;
+    int compiled = -1, alpha = 0;
+    skn = (AWE_SKIN*)calloc(1, sizeof(AWE_SKIN));
     if(!skn)
+        return NULL;
+    skn->obj_list = awe_sbt_init();
+    if(filename)
+        compiled = _load_compiled_skin(skn, filename);
+    if(compiled == 0)
         goto _skin_error;
-    if(filename){
-        skn->dat = load_datafile(filename);
-        if(skn->dat){
-            i = _get_dat_idx(skn->dat, "ALPHA_CFG");
-            alpha = _get_dat_int(skn->dat, i, DAT_ID('C', 'F', 'G', 'A'), 0);                
+    if(compiled < 0 && filename){
+        /* Read the alpha configuration alone, so as that the datafile is loaded once */
+        if((cfg = load_datafile_object(filename, "ALPHA_CFG")) != NULL){
+            tmp = get_datafile_property(cfg, DAT_ID('C', 'F', 'G', 'A'));
+            alpha = *tmp == '\0' ? 0 : atoi(tmp);
+            unload_datafile_object(cfg);
         }
-    }
-    /* Set color conversion if alpha channel is present */
-    if(alpha){
-        unload_datafile(skn->dat);
-        set_color_conversion(COLORCONV_EXPAND_HI_TO_TRUE);
+        /* Set color conversion if alpha channel is present */
+        if(alpha)
+            set_color_conversion(COLORCONV_EXPAND_HI_TO_TRUE);
         skn->dat = load_datafile(filename);
+        if(alpha)
+            set_color_conversion(COLORCONV_TOTAL);
+        if(!skn->dat)
+            goto _skin_error;
+        /* Pack bitmaps into atlases before anything references them */
+        if(!_pack_atlases(skn))
+            goto _skin_error;
+        if(!_load_objects(skn))
+            goto _skin_error;
+        if(!_load_texture_references(skn))
+            goto _skin_error;
+        if(!_load_references(skn))
+            goto _skin_error;
     }
     if(!skn->dat)
         goto _skin_error;
-    /* Load cursor */
-    awe_load_datafile_mouse(skn->dat);
-    skn->obj_list = awe_sbt_init();
-    if(!_load_objects(skn))
-        goto _skin_error;
-    if(!_load_texture_references(skn))
+    if(!_build_skin_index(skn))
         goto _skin_error;
-    if(!_load_references(skn))
+    /* Remember the file, so as that the skin can be reloaded */
+    if((skn->filename = ustrdup(filename)) == NULL)
         goto _skin_error;
-    if(alpha)
-        set_color_conversion(COLORCONV_TOTAL);
+    skn->file_time = file_time(filename);
+    /* Load cursor */
+    if(load_mouse)
+        awe_load_datafile_mouse(skn->dat);
     TRACE("Skin: Loaded Successfully\n");
     return skn;
     _skin_error:
@@ -457,18 +1503,358 @@ AWE_SKIN *awe_load_skin(const char *filename){
 }
 
 
+static int _same_bitmap(BITMAP *a, BITMAP *b){
+    int size, y;
+    if(!a || !b)
+        return a == b;
+    if(a->w != b->w || a->h != b->h || bitmap_color_depth(a) != bitmap_color_depth(b))
+        return FALSE;
+    if(!is_memory_bitmap(a) || !is_memory_bitmap(b))
+        return FALSE;
+    size = a->w * BYTES_PER_PIXEL(bitmap_color_depth(a));
+    for(y = 0; y < a->h; y++){
+        if(memcmp(a->line[y], b->line[y], size) != 0)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+
+static int _same_color(RGB *a, RGB *b){
+    return a->r == b->r && a->g == b->g && a->b == b->b;
+}
+
+
+static int _same_texture(AWE_TEXTURE *a, AWE_TEXTURE *b){
+    int i;
+    for(i = 0; i < 4; i++){
+        if(a->side[i] != b->side[i])
+            return FALSE;
+    }
+    for(i = 0; i < 9; i++){
+        if(!_same_bitmap(a->bitmap[i], b->bitmap[i]))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+
+static int _rebind_compare_func(const void *a, const void *b){
+    unsigned long data1 = (unsigned long)((_SKIN_REBIND*)a)->old_data;
+    unsigned long data2 = (unsigned long)((_SKIN_REBIND*)b)->old_data;
+    return data1 < data2 ? -1 : data1 > data2;
+}
+
+
+static int _pointer_compare_func(const void *a, const void *b){
+    unsigned long data1 = (unsigned long)*(void**)a;
+    unsigned long data2 = (unsigned long)*(void**)b;
+    return data1 < data2 ? -1 : data1 > data2;
+}
+
+
+/* matches the created textures, fonts and bitmaps of the old skin with the
+   objects of the new one. textures are moved into the structs of the old
+   ones, which the new skin takes over, so as that their address is kept;
+   other objects are rebound through the widget properties.
+ */
+static int _match_skin_objects(_SKIN_RELOAD *reload, AWE_SKIN *old_skn, AWE_SKIN *new_skn){
+    _SKIN_OBJECT *obj, *new_obj;
+    AWE_TEXTURE tmp;
+    void *data;
+    char *moved;
+    int i;
+    if((moved = (char*)calloc(old_skn->object_count + 1, 1)) == NULL)
+        return 0;
+    reload->rebind = (_SKIN_REBIND*)malloc((old_skn->object_count + 1) * sizeof(_SKIN_REBIND));
+    reload->changed = (void**)malloc((old_skn->object_count + 1) * sizeof(void*));
+    reload->recolor = (_SKIN_RECOLOR*)malloc((old_skn->object_count + 1) * sizeof(_SKIN_RECOLOR));
+    if(!reload->rebind || !reload->changed || !reload->recolor){
+        free(moved);
+        return 0;
+    }
+    /* Textures first, before links of the new skin take their data */
+    for(i = 0; i < old_skn->object_count; i++){
+        obj = (_SKIN_OBJECT*)old_skn->objects[i];
+        if(obj->type != SKIN_TEXTURE || !obj->data || obj->link)
+            continue;
+        new_obj = _find_skin_object(new_skn, obj->name);
+        if(!new_obj || new_obj->type != SKIN_TEXTURE || new_obj->link || new_obj->loaded)
+            continue;
+        _load_skin_object(new_obj);
+        if(!new_obj->data)
+            continue;
+        TRACE("Skin: Updating texture %s\n", obj->name);
+        if(!_same_texture((AWE_TEXTURE*)obj->data, (AWE_TEXTURE*)new_obj->data))
+            reload->changed[reload->changed_count++] = obj->data;
+        tmp = *(AWE_TEXTURE*)obj->data;
+        *(AWE_TEXTURE*)obj->data = *(AWE_TEXTURE*)new_obj->data;
+        *(AWE_TEXTURE*)new_obj->data = tmp;
+        /* Each skin destroys the struct it ends up with */
+        data = obj->data;
+        obj->data = new_obj->data;
+        new_obj->data = data;
+        awe_flush_texture_cache((AWE_TEXTURE*)new_obj->data);
+        moved[i] = TRUE;
+    }
+    for(i = 0; i < old_skn->object_count; i++){
+        obj = (_SKIN_OBJECT*)old_skn->objects[i];
+        if(moved[i] || !obj->data || obj->link)
+            continue;
+        if(obj->type != SKIN_TEXTURE && obj->type != SKIN_FONT && obj->type != SKIN_BITMAP)
+            continue;
+        reload->rebind[reload->rebind_count].old_data = obj->data;
+        reload->rebind[reload->rebind_count].new_data = obj->type == SKIN_FONT ? font : NULL;
+        new_obj = _find_skin_object(new_skn, obj->name);
+        if(new_obj && new_obj->type == obj->type){
+            _load_skin_object(new_obj);
+            if(new_obj->data)
+                reload->rebind[reload->rebind_count].new_data = new_obj->data;
+        }
+        if(reload->rebind[reload->rebind_count].new_data != obj->data)
+            reload->rebind_count++;
+    }
+    /* Widgets keep copies of colors, so colors are matched by value; a
+       color the widgets got from the skin is looked up by its name */
+    for(i = 0; i < old_skn->object_count; i++){
+        obj = (_SKIN_OBJECT*)old_skn->objects[i];
+        if(obj->type != SKIN_RGB || !obj->data)
+            continue;
+        new_obj = _find_skin_object(new_skn, obj->name);
+        if(!new_obj || new_obj->type != SKIN_RGB)
+            continue;
+        _load_skin_object(new_obj);
+        if(!new_obj->data || _same_color((RGB*)obj->data, (RGB*)new_obj->data))
+            continue;
+        reload->recolor[reload->recolor_count].old_col = *(RGB*)obj->data;
+        reload->recolor[reload->recolor_count].new_col = *(RGB*)new_obj->data;
+        reload->recolor_count++;
+    }
+    free(moved);
+    qsort(reload->rebind, reload->rebind_count, sizeof(_SKIN_REBIND), _rebind_compare_func);
+    qsort(reload->changed, reload->changed_count, sizeof(void*), _pointer_compare_func);
+    return 1;
+}
+
+
+static int _is_skin_property(const char *type){
+    return strcmp(type, AWE_TEXTURE_PROPERTY) == 0 || strcmp(type, "FONT *") == 0 || strcmp(type, "BITMAP *") == 0;
+}
+
+
+/* sets a color property of a widget to the new color of the skin, if it
+   has the old value of a color that has changed
+ */
+static void _recolor_property(_SKIN_RELOAD *reload, AWE_WIDGET *wgt, AWE_CLASS_PROPERTY *prop){
+    RGB col;
+    int i;
+    prop->get((AWE_OBJECT*)wgt, &col);
+    for(i = 0; i < reload->recolor_count; i++){
+        if(_same_color(&col, &reload->recolor[i].old_col)){
+            awe_set_object_properties((AWE_OBJECT*)wgt, prop->name, reload->recolor[i].new_col, NULL);
+            return;
+        }
+    }
+}
+
+
+/* points the properties of a widget tree that reference objects of the old
+   skin to the new ones, and redraws widgets whose textures have changed
+ */
+static void _rebind_widget(_SKIN_RELOAD *reload, AWE_WIDGET *wgt){
+    AWE_CLASS *pclass;
+    AWE_CLASS_PROPERTY *prop;
+    AWE_WIDGET *child;
+    _SKIN_REBIND key, *rebind;
+    for(pclass = wgt->object.pclass; pclass; pclass = pclass->super){
+        for(prop = pclass->properties; prop && prop->name; prop++){
+            if(!prop->get)
+                continue;
+            if(reload->recolor_count && prop->set && strcmp(prop->type, "RGB") == 0){
+                _recolor_property(reload, wgt, prop);
+                continue;
+            }
+            if(!_is_skin_property(prop->type))
+                continue;
+            prop->get((AWE_OBJECT*)wgt, &key.old_data);
+            if(!key.old_data)
+                continue;
+            rebind = (_SKIN_REBIND*)bsearch(&key, reload->rebind, reload->rebind_count, sizeof(_SKIN_REBIND), _rebind_compare_func);
+            if(rebind){
+                awe_set_object_properties((AWE_OBJECT*)wgt, prop->name, rebind->new_data, NULL);
+                /* Objects missing from the new skin leave the widget without one */
+                awe_set_widget_dirty(wgt);
+            }
+            else if(bsearch(&key.old_data, reload->changed, reload->changed_count, sizeof(void*), _pointer_compare_func))
+                awe_set_widget_dirty(wgt);
+        }
+    }
+    AWE_CALL_METHOD(wgt, AWE_ID_SKIN, AWE_ID_AWE, AWE_SKIN_VTABLE, apply_skin, ((AWE_OBJECT*)wgt, reload->skn));
+    for(child = awe_get_first_child_widget(wgt); child; child = awe_get_next_sibling_widget(child))
+        _rebind_widget(reload, child);
+}
+
+
+/*****************************************************************************
+    PUBLIC
+ *****************************************************************************/
+
+
+AWE_SKIN *awe_load_skin(const char *filename){
+    return _load_skin(filename, TRUE);
+}
+
+
+AWE_SKIN *awe_read_skin(const char *filename){
+    return _load_skin(filename, FALSE);
+}
+
+
+int awe_compile_skin(const char *filename, const char *compiled){
+    _SKIN_WRITER w;
+    PACKFILE *f;
+    int ret = 0;
+    memset(&w, 0, sizeof(w));
+    /* The skin is loaded without its cursors, which stay untouched */
+    if((w.skn = _load_skin(filename, FALSE)) == NULL)
+        return 0;
+    if(w.skn->image){
+        TRACE("Skin: %s is already compiled\n", filename);
+        goto _skin_error;
+    }
+    if(!_write_compiled_skin(&w))
+        goto _skin_error;
+    if((f = pack_fopen(compiled, F_WRITE)) == NULL)
+        goto _skin_error;
+    ret = pack_fwrite(w.data, w.size, f) == w.size;
+    pack_fclose(f);
+    TRACE("Skin: Compiled %s to %s\n", filename, compiled);
+    _skin_error:
+    free(w.data);
+    free(w.page);
+    awe_unload_skin(w.skn);
+    return ret;
+}
+
+
 void awe_unload_skin(AWE_SKIN *skn){
-    if(skn->dat)
-        unload_datafile(skn->dat);
+    int i;
+    if(skn->dat){
+        if(skn->image)
+            _unload_compiled_datafile(skn->dat);
+        else
+            unload_datafile(skn->dat);
+    }
+    for(i = 0; i < skn->object_count; i++){
+        if(skn->objects[i])
+            _skin_delete_func(skn->objects[i]);
+    }
+    free(skn->objects);
+    free(skn->hash);
     awe_sbt_destroy(&skn->obj_list, _skin_delete_func);
+    /* Atlases and the image go last, the objects above reference them */
+    for(i = 0; i < skn->atlas_count; i++)
+        destroy_bitmap(skn->atlas[i]);
+    free(skn->atlas);
+    free(skn->image);
+    free(skn->prefetch);
+    free(skn->filename);
     free(skn);
     TRACE("Skin: Unloaded Successfully\n");
 }
 
 
+int awe_reload_skin(AWE_SKIN *skn, const char *filename, AWE_WIDGET *wgt){
+    _SKIN_RELOAD reload;
+    AWE_SKIN *new_skn, tmp;
+    if(!filename)
+        filename = skn->filename;
+    /* The cursors are loaded once the reload can not fail, since they point into the datafile */
+    if((new_skn = _load_skin(filename, FALSE)) == NULL)
+        return 0;
+    memset(&reload, 0, sizeof(reload));
+    if(!_match_skin_objects(&reload, skn, new_skn)){
+        free(reload.rebind);
+        free(reload.changed);
+        free(reload.recolor);
+        awe_unload_skin(new_skn);
+        return 0;
+    }
+    /* The skin takes the new contents; the old ones are unloaded once no widget references them */
+    tmp = *skn;
+    *skn = *new_skn;
+    *new_skn = tmp;
+    awe_load_datafile_mouse(skn->dat);
+    reload.skn = skn;
+    if(!wgt)
+        wgt = awe_get_root_widget();
+    if(wgt)
+        _rebind_widget(&reload, wgt);
+    free(reload.rebind);
+    free(reload.changed);
+    free(reload.recolor);
+    awe_unload_skin(new_skn);
+    TRACE("Skin: Reloaded %s\n", filename);
+    return 1;
+}
+
+
+int awe_update_skin(AWE_SKIN *skn, AWE_WIDGET *wgt){
+    time_t t;
+    if(!skn->filename)
+        return 0;
+    t = file_time(skn->filename);
+    if(t == 0 || t == skn->file_time)
+        return 0;
+    /* A skin that fails to load is not retried until it is modified again */
+    skn->file_time = t;
+    return awe_reload_skin(skn, NULL, wgt);
+}
+
+
+int awe_set_skin_prefetch_list(AWE_SKIN *skn, const char **names){
+    _SKIN_OBJECT *obj;
+    void **prefetch;
+    int count = 0, i;
+    for(i = 0; names && names[i]; i++)
+        count++;
+    if((prefetch = (void**)malloc((count + 1) * sizeof(void*))) == NULL)
+        return 0;
+    free(skn->prefetch);
+    skn->prefetch = prefetch;
+    skn->prefetch_count = 0;
+    /* Kept in reverse order, so as that the first name is prefetched first */
+    for(i = count - 1; i >= 0; i--){
+        obj = _find_skin_object(skn, names[i]);
+        if(obj && !obj->loaded)
+            skn->prefetch[skn->prefetch_count++] = obj;
+    }
+    return 1;
+}
+
+
+int awe_prefetch_skin(AWE_SKIN *skn, int count){
+    while(count-- > 0 && skn->prefetch_count > 0)
+        _load_skin_object((_SKIN_OBJECT*)skn->prefetch[--skn->prefetch_count]);
+    return skn->prefetch_count;
+}
+
+
+int awe_get_skin_handle(AWE_SKIN *skn, const char *name){
+    if(!skn->hash)
+        return -1;
+    return _find_skin_handle(skn, name);
+}
+
+
 AWE_TEXTURE *awe_get_skin_texture(AWE_SKIN *skn, const char *name){
+    return awe_get_skin_texture_by_handle(skn, awe_get_skin_handle(skn, name));
+}
+
+
+AWE_TEXTURE *awe_get_skin_texture_by_handle(AWE_SKIN *skn, int handle){
     _SKIN_OBJECT *obj;
-    obj = _get_skin_object(skn, name);
+    obj = _get_skin_object(skn, handle);
     if(obj && obj->type == SKIN_TEXTURE)
         return (AWE_TEXTURE*)obj->data;
     return NULL;
@@ -476,8 +1862,13 @@ AWE_TEXTURE *awe_get_skin_texture(AWE_SKIN *skn, const char *name){
 
 
 RGB *awe_get_skin_color(AWE_SKIN *skn, const char *name){
+    return awe_get_skin_color_by_handle(skn, awe_get_skin_handle(skn, name));
+}
+
+
+RGB *awe_get_skin_color_by_handle(AWE_SKIN *skn, int handle){
     _SKIN_OBJECT *obj;
-    obj = _get_skin_object(skn, name);
+    obj = _get_skin_object(skn, handle);
     if(obj && obj->type == SKIN_RGB)
         return (RGB*)obj->data;
     return &_default_color;
@@ -485,8 +1876,13 @@ RGB *awe_get_skin_color(AWE_SKIN *skn, const char *name){
 
 
 FONT *awe_get_skin_font(AWE_SKIN *skn, const char *name){
+    return awe_get_skin_font_by_handle(skn, awe_get_skin_handle(skn, name));
+}
+
+
+FONT *awe_get_skin_font_by_handle(AWE_SKIN *skn, int handle){
     _SKIN_OBJECT *obj;
-    obj = _get_skin_object(skn, name);
+    obj = _get_skin_object(skn, handle);
     if(obj && obj->type == SKIN_FONT)
         return (FONT*)obj->data;
     return font;
@@ -494,8 +1890,13 @@ FONT *awe_get_skin_font(AWE_SKIN *skn, const char *name){
 
 
 BITMAP *awe_get_skin_bitmap(AWE_SKIN *skn, const char *name){
+    return awe_get_skin_bitmap_by_handle(skn, awe_get_skin_handle(skn, name));
+}
+
+
+BITMAP *awe_get_skin_bitmap_by_handle(AWE_SKIN *skn, int handle){
     _SKIN_OBJECT *obj;
-    obj = _get_skin_object(skn, name);
+    obj = _get_skin_object(skn, handle);
     if(obj && obj->type == SKIN_BITMAP)
         return (BITMAP*)obj->data;
     return NULL;
@@ -503,8 +1904,13 @@ BITMAP *awe_get_skin_bitmap(AWE_SKIN *skn, const char *name){
 
 
 AWE_SKIN_ANIM *awe_get_skin_anim(AWE_SKIN *skn, const char *name){
+    return awe_get_skin_anim_by_handle(skn, awe_get_skin_handle(skn, name));
+}
+
+
+AWE_SKIN_ANIM *awe_get_skin_anim_by_handle(AWE_SKIN *skn, int handle){
     _SKIN_OBJECT *obj;
-    obj = _get_skin_object(skn, name);
+    obj = _get_skin_object(skn, handle);
     if(obj && obj->type == SKIN_ANIM)
         return (AWE_SKIN_ANIM*)obj->data;
     return &_default_anim;
@@ -512,8 +1918,13 @@ AWE_SKIN_ANIM *awe_get_skin_anim(AWE_SKIN *skn, const char *name){
 
 
 void *awe_get_skin_data(AWE_SKIN *skn, const char *name){
+    return awe_get_skin_data_by_handle(skn, awe_get_skin_handle(skn, name));
+}
+
+
+void *awe_get_skin_data_by_handle(AWE_SKIN *skn, int handle){
     _SKIN_OBJECT *obj;
-    obj = _get_skin_object(skn, name);
+    obj = _get_skin_object(skn, handle);
     if(obj)
         return (void*)obj->data;
     return NULL;
@@ -521,10 +1932,15 @@ void *awe_get_skin_data(AWE_SKIN *skn, const char *name){
 
 
 int awe_get_skin_int(AWE_SKIN *skn, const char *name, int num){
+    return awe_get_skin_int_by_handle(skn, awe_get_skin_handle(skn, name), num);
+}
+
+
+int awe_get_skin_int_by_handle(AWE_SKIN *skn, int handle, int num){
     _SKIN_OBJECT *obj;
     static int tmp2;
     tmp2 = num;
-    obj = _get_skin_object(skn, name);
+    obj = _get_skin_object(skn, handle);
     if(obj && obj->type == SKIN_INT){
         memcpy(&tmp2, obj->data, sizeof(int));
         if(_test_byte_order() == BIG_ENDIAN)
@@ -12,6 +12,8 @@ static RGB _edge_color_top_left     = { 241, 239, 226, 0 };
 static RGB _edge_color_bottom_right = { 128, 128, 128, 0 };
 static RGB _bar_color_top           = { 128, 128, 128, 0 };
 static RGB _bar_color_bottom        = { 241, 239, 226, 0 };
+static RGB _background_color        = { 212, 208, 200, 0 };
+static RGB _focus_color             = { 0  , 0  , 0  , 0 };
 
 
 #define DEFAULT_HANDLE_WIDTH        9
@@ -78,6 +80,7 @@ static void _slider_constructor(AWE_OBJECT *obj)
         memcpy(&tmp->edge_col[i][AWE_SLIDER_EDGE_TOP_LEFT], &_edge_color_top_left, sizeof(RGB));
         memcpy(&tmp->edge_col[i][AWE_SLIDER_EDGE_BOTTOM_RIGHT], &_edge_color_bottom_right, sizeof(RGB));
     }
+    tmp->color_version = 0;
 }
 
 
@@ -405,6 +408,25 @@ AWE_OBJECT *awe_slider_clone(AWE_OBJECT *wgt)
 }
 
 
+//makes the pixel values of the colors, if out of date
+static void _slider_make_colors(AWE_SLIDER *sldr)
+{
+    int i, j;
+
+    if (sldr->color_version == awe_get_color_version()) return;
+    for(i = 0; i < AWE_SLIDER_NUM_TEXTURES; i++){
+        sldr->face_pix[i] = AWE_MAKE_COLOR(sldr->face_col[i]);
+        for(j = 0; j < AWE_SLIDER_NUM_EDGES; j++)
+            sldr->edge_pix[i][j] = AWE_MAKE_COLOR(sldr->edge_col[i][j]);
+    }
+    for(j = 0; j < AWE_SLIDER_NUM_EDGES; j++)
+        sldr->bar_pix[j] = AWE_MAKE_COLOR(sldr->bar_col[j]);
+    sldr->bg_pix = AWE_MAKE_COLOR(_background_color);
+    sldr->focus_pix = AWE_MAKE_COLOR(_focus_color);
+    sldr->color_version = awe_get_color_version();
+}
+
+
 //slider paint
 void awe_slider_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *clip)
 {
@@ -422,17 +444,18 @@ void awe_slider_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *clip)
     else
         state = AWE_SLIDER_TEXTURE_ENABLED;
 
-    awe_fill_rect_s(canvas, 0, 0, wgt->width, wgt->height, makecol(212, 208, 200));
+    _slider_make_colors(sldr);
+    awe_fill_rect_s(canvas, 0, 0, wgt->width, wgt->height, sldr->bg_pix);
     if(sldr->orientation){
         awe_draw_3d_rect_s(canvas, (wgt->width >> 1) - 2, 0, 4, wgt->height,
-            AWE_MAKE_COLOR(sldr->bar_col[0]),
-            AWE_MAKE_COLOR(sldr->bar_col[1]),
+            sldr->bar_pix[0],
+            sldr->bar_pix[1],
             2);
     }
     else{
         awe_draw_3d_rect_s(canvas, 0, (wgt->height >> 1) - 2, wgt->width, 4, 
-            AWE_MAKE_COLOR(sldr->bar_col[0]),
-            AWE_MAKE_COLOR(sldr->bar_col[1]),
+            sldr->bar_pix[0],
+            sldr->bar_pix[1],
             2);
         /* Ticks: to be added later */
         //if(sldr->step > 0){
@@ -451,50 +474,50 @@ void awe_slider_paint(AWE_WIDGET *wgt, AWE_CANVAS *canvas, const AWE_RECT *clip)
         //}
     }
     if (awe_get_focus_widget() == wgt && state != AWE_SLIDER_TEXTURE_DISABLED)
-        awe_draw_rect_pattern_s(canvas, 0, 0, wgt->width, wgt->height, makecol(0, 0, 0), AWE_PATTERN_DOT_DOT);
+        awe_draw_rect_pattern_s(canvas, 0, 0, wgt->width, wgt->height, sldr->focus_pix, AWE_PATTERN_DOT_DOT);
     if(sldr->orientation){
         awe_fill_rect_s(canvas, 2, pos + 2, wgt->width - 4, sldr->handle_width - 4, 
-            AWE_MAKE_COLOR(sldr->face_col[state]));
+            sldr->face_pix[state]);
         switch(sldr->handle_type){
             case AWE_SLIDER_HANDLE_LEFT:
                 awe_draw_3d_slider_left_s(canvas, 0, pos, wgt->width, sldr->handle_width, 
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_TOP_LEFT]),
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT]), 
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_TOP_LEFT],
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT], 
                     2);
             break;
             case AWE_SLIDER_HANDLE_RIGHT:
                 awe_draw_3d_slider_right_s(canvas, 0, pos, wgt->width, sldr->handle_width, 
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_TOP_LEFT]),
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT]), 
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_TOP_LEFT],
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT], 
                     2);
             break;
             default:
                 awe_draw_3d_rect_s(canvas, 0, pos, wgt->width, sldr->handle_width, 
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_TOP_LEFT]),
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT]), 
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_TOP_LEFT],
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT], 
                     2);
         }       
     }
     else{
         awe_fill_rect_s(canvas, pos + 2, 2, sldr->handle_width - 4, wgt->height - 4, 
-            AWE_MAKE_COLOR(sldr->face_col[state]));
+            sldr->face_pix[state]);
         switch(sldr->handle_type){
             case AWE_SLIDER_HANDLE_UP:
                 awe_draw_3d_slider_up_s(canvas, pos, 0, sldr->handle_width, wgt->height, 
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_TOP_LEFT]),
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT]), 
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_TOP_LEFT],
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT], 
                     2);
             break;
             case AWE_SLIDER_HANDLE_DOWN:
                 awe_draw_3d_slider_down_s(canvas, pos, 0, sldr->handle_width, wgt->height, 
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_TOP_LEFT]),
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT]), 
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_TOP_LEFT],
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT], 
                     2);
             break;
             default:
                 awe_draw_3d_rect_s(canvas, pos, 0, sldr->handle_width, wgt->height, 
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_TOP_LEFT]),
-                    AWE_MAKE_COLOR(sldr->edge_col[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT]), 
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_TOP_LEFT],
+                    sldr->edge_pix[state][AWE_SLIDER_EDGE_BOTTOM_RIGHT], 
                     2);
         }
     }
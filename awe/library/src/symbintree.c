@@ -362,3 +362,13 @@ void *awe_sbt_find(AWE_SBT_NODE *root, void *data, int (*compare_func)(const voi
 void awe_sbt_destroy(AWE_SBT_NODE **root, void (*delete_func)(const void *data)){
     while(awe_sbt_delete(root, NULL, _sbt_delete_all, delete_func) == AWE_STATUS_OK);
 }
+
+
+//calls a function for the data of every node, in sorted order
+void awe_sbt_walk(AWE_SBT_NODE *root, void (*walk_func)(void *data, void *arg), void *arg){
+    if(root == NIL)
+        return;
+    awe_sbt_walk(root->left, walk_func, arg);
+    walk_func(root->data, arg);
+    awe_sbt_walk(root->right, walk_func, arg);
+}
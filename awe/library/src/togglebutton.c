@@ -78,7 +78,8 @@ AWE_PUSH_BUTTON_VTABLE awe_toggle_button_vtable = {
     ,
     //control
     {
-        awe_push_button_key_press
+        awe_push_button_key_press,
+        awe_push_button_get_hot_key
     }
     ,
     //geometry
@@ -1,6 +1,7 @@
 #include "widget.h"
 #include <string.h>
 #include "mouse.h"
+#include "animation.h"
 
 
 /*****************************************************************************
@@ -35,6 +36,8 @@ static void _gui_update_full();
 static BITMAP *_gui_screen = 0;
 static AWE_WIDGET *_root_widget = 0;
 static AWE_WIDGET *_focus_widget = 0;
+static unsigned _widget_tree_version = 0;
+static unsigned _gui_color_version = 0;
 static AWE_WIDGET_OUTPUT_TYPE _widget_output_type = AWE_WIDGET_OUTPUT_DIRECT;
 static AWE_GUI_UPDATE_MODE _gui_update_mode = AWE_GUI_UPDATE_CHANGES;
 static void (*_gui_update_proc)() = _gui_update_changes;
@@ -153,13 +156,33 @@ static void _set_enabled_tree(AWE_WIDGET *wgt)
 
 
 //sets a widget tree to be on screen
-static void _set_on_screen(AWE_WIDGET *wgt)
+static void _set_on_screen_helper(AWE_WIDGET *wgt)
 {
     AWE_WIDGET *child;
 
     wgt->on_screen = 1;
     for(child = _FIRST(wgt); child; child = _NEXT(child)) {
-        _set_on_screen(child);
+        _set_on_screen_helper(child);
+    }
+}
+
+
+//sets a widget tree to be on screen and resumes its animations
+static void _set_on_screen(AWE_WIDGET *wgt)
+{
+    _set_on_screen_helper(wgt);
+    awe_resume_widget_animations(wgt);
+}
+
+
+//sets a widget tree to be repainted
+static void _set_tree_dirty(AWE_WIDGET *wgt)
+{
+    AWE_WIDGET *child;
+
+    awe_set_widget_dirty(wgt);
+    for(child = _FIRST(wgt); child; child = _NEXT(child)) {
+        _set_tree_dirty(child);
     }
 }
 
@@ -227,6 +250,7 @@ static void _clean_up_widget(AWE_WIDGET *wgt)
 {
     awe_enum_events(_remove_widget_timer_events_proc, wgt);
     awe_enum_timers(_remove_widget_timers_proc, wgt);
+    awe_pause_widget_animations(wgt);
     _clean_up_widget_helper(wgt);
 }
 
@@ -471,15 +495,19 @@ static void _redraw_widget(AWE_WIDGET *wgt)
 {
     int cl, ct, cr, cb;
     AWE_RECT t;
-    BITMAP *tmp = _mouse_screen;  
-  
+    int scare;
+
     AWE_RECT_INTERSECTION(t, wgt->clip, wgt->dirty);
 
     //acquire bitmap
     acquire_bitmap(_gui_screen);
 
-    //hide mouse
-    if (tmp == _gui_screen)
+    /* hide mouse; a cursor shown on a buffered gui is composited when the
+       buffer is presented, so only a gui drawn straight onto the mouse screen
+       needs to hide it
+     */
+    scare = _mouse_screen == _gui_screen && _gui_screen == awe_get_mouse_screen();
+    if (scare)
         awe_scare_mouse_area(t.left, t.top, AWE_RECT_WIDTH(t), AWE_RECT_HEIGHT(t));
 
     //save screen clipping
@@ -498,7 +526,7 @@ static void _redraw_widget(AWE_WIDGET *wgt)
     _gui_screen->cb = cb;
 
     //show mouse
-    if (tmp == _gui_screen) 
+    if (scare)
         awe_unscare_mouse();
 
     //release bitmap
@@ -648,6 +676,9 @@ static void _widget_destructor(AWE_OBJECT *obj)
     if (wgt->parent) awe_remove_widget(wgt);
     else if (wgt == _root_widget) awe_set_root_widget(0);
 
+    //stop animations; widgets removed from the screen only pause them
+    awe_stop_widget_animations(wgt);
+
     //destroy children
     for(child = _FIRST(wgt); child; child = _NEXT(child)) {
         awe_destroy_widget(child);
@@ -760,6 +791,23 @@ static void _widget_set_height(AWE_OBJECT *wgt, void *buffer)
 }
 
 
+//retrieves the value of the relevant property
+static void _widget_get_tab_order(AWE_OBJECT *wgt, void *buffer)
+{
+    *(int *)buffer = _WGT->tab_order;
+}
+
+
+//sets the value of the relevant property
+static void _widget_set_tab_order(AWE_OBJECT *wgt, void *buffer)
+{
+    int value = *(int *)buffer;
+    if (_WGT->tab_order == value) return;
+    _WGT->tab_order = value;
+    _widget_tree_version++;
+}
+
+
 //sets the value of the relevant property
 static void _widget_set_visible(AWE_OBJECT *wgt, void *buffer)
 {
@@ -893,6 +941,7 @@ AWE_CLASS_PROPERTY awe_widget_properties[] = {
     {AWE_ID_OPAQUE      , "bool"                  , sizeof(int)                   , _widget_get_opaque      , _widget_set_opaque      , 0},
     {AWE_ID_TRANSLUCENCY, "int"                   , sizeof(int)                   , _widget_get_translucency, _widget_set_translucency, 0},
     {AWE_ID_OUTPUT_TYPE , "AWE_WIDGET_OUTPUT_TYPE", sizeof(AWE_WIDGET_OUTPUT_TYPE), _widget_get_output_type , _widget_set_output_type , _output_type_enum},
+    {AWE_ID_TAB_ORDER   , "int"                   , sizeof(int)                   , _widget_get_tab_order   , _widget_set_tab_order   , 0},
     {0}
 };
 
@@ -1009,6 +1058,7 @@ AWE_OBJECT *awe_widget_clone(AWE_OBJECT *wgt)
         AWE_ID_OPAQUE      , _WGT->opaque      ,
         AWE_ID_TRANSLUCENCY, _WGT->translucency,
         AWE_ID_OUTPUT_TYPE , _WGT->output_type ,
+        AWE_ID_TAB_ORDER   , _WGT->tab_order   ,
         0);
 }
 
@@ -1159,6 +1209,7 @@ int awe_widget_insert_widget(AWE_WIDGET *wgt, AWE_WIDGET *child, int z_order)
     _insert_widget(wgt, child, z_order);
     child->parent = wgt;
     wgt->children_count++;
+    _widget_tree_version++;
 
     //set the enabled tree flag
     _set_enabled_tree(wgt);
@@ -1183,6 +1234,7 @@ int awe_widget_remove_widget(AWE_WIDGET *wgt, AWE_WIDGET *child)
     //remove
     awe_list_remove(&wgt->children, &child->node.node);
     wgt->children_count--;
+    _widget_tree_version++;
 
     //set the enabled tree flag
     _set_enabled_tree(wgt);
@@ -1522,6 +1574,13 @@ int awe_set_focus_widget(AWE_WIDGET *wgt)
 }
 
 
+//returns the version of the widget trees
+unsigned awe_get_widget_tree_version()
+{
+    return _widget_tree_version;
+}
+
+
 //sets up widgets that fall inside the given rectangle to be updated
 void awe_set_widget_dirty_rect(AWE_WIDGET *wgt, AWE_RECT *r)
 {
@@ -1590,6 +1649,7 @@ void awe_set_widget_z_order(AWE_WIDGET *wgt, int z_order)
     //check for change
     z_order = awe_get_widget_z_order(wgt);
     if (prev_z == z_order) return;
+    _widget_tree_version++;
 
     //update the screen
     if (wgt->on_screen) {
@@ -1725,7 +1785,16 @@ void awe_set_gui_update_mode(AWE_GUI_UPDATE_MODE mode, AWE_DRS_PROC drs_proc)
 //updates the GUI
 void awe_update_gui()
 {
-    if (_root_widget) _gui_update_proc();
+    awe_update_animations();
+    if (!_root_widget) return;
+
+    //widgets repaint with new pixel values when the colors change
+    awe_check_color_depth(_gui_screen);
+    if (_gui_color_version != awe_get_color_version()) {
+        _gui_color_version = awe_get_color_version();
+        _set_tree_dirty(_root_widget);
+    }
+    _gui_update_proc();
 }
 
 